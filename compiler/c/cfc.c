@@ -46,6 +46,8 @@ struct CFCArgs {
     char  *header_filename;
     char  *footer_filename;
     int    charmonic;
+    int    static_vtables;
+    int    const_offsets;
 };
 typedef struct CFCArgs CFCArgs;
 
@@ -114,6 +116,14 @@ S_parse_arguments(int argc, char **argv, CFCArgs *args) {
             args->charmonic = 1;
             continue;
         }
+        if (strcmp(arg, "--static-vtables") == 0) {
+            args->static_vtables = 1;
+            continue;
+        }
+        if (strcmp(arg, "--const-offsets") == 0) {
+            args->const_offsets = 1;
+            continue;
+        }
         if (S_parse_string_argument(arg, "--dest", &args->dest)) {
             continue;
         }
@@ -230,6 +240,16 @@ main(int argc, char **argv) {
 
     CFCHierarchy_build(hierarchy);
 
+    if (args.const_offsets) {
+        CFCParcel **parcels = CFCParcel_all_parcels();
+
+        for (i = 0; parcels[i]; ++i) {
+            if (!CFCParcel_included(parcels[i])) {
+                CFCParcel_set_const_offsets(parcels[i], 1);
+            }
+        }
+    }
+
     if (args.header_filename) {
         header = CFCUtil_slurp_text(args.header_filename, &file_len);
     }
@@ -244,6 +264,7 @@ main(int argc, char **argv) {
     }
 
     core_binding = CFCBindCore_new(hierarchy, header, footer, args.charmonic);
+    CFCBindCore_set_static_vtables(core_binding, args.static_vtables);
     CFCBindCore_write_all_modified(core_binding, 0);
 
     c_binding = CFCC_new(hierarchy, header, footer);
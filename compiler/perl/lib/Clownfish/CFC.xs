@@ -902,6 +902,7 @@ ALIAS:
     set_host_alias     = 19
     get_host_alias     = 20
     excluded_from_host = 22
+    monomorphic        = 24
 PPCODE:
 {
     START_SET_OR_GET_SWITCH
@@ -934,6 +935,9 @@ PPCODE:
         case 22:
             retval = newSViv(CFCMethod_excluded_from_host(self));
             break;
+        case 24:
+            retval = newSViv(CFCMethod_monomorphic(self));
+            break;
     END_SET_OR_GET_SWITCH
 }
 
@@ -2171,6 +2175,13 @@ exclude_method(self, method)
 PPCODE:
     CFCPerlClass_exclude_method(self, method);
 
+void
+fast_callback(self, method)
+    CFCPerlClass *self;
+    const char *method;
+PPCODE:
+    CFCPerlClass_fast_callback(self, method);
+
 void
 exclude_constructor(self)
     CFCPerlClass *self;
@@ -291,10 +291,19 @@ CFCBindClass_to_c_data(CFCBindClass *self) {
     for (int meth_num = 0; methods[meth_num] != NULL; meth_num++) {
         CFCMethod *method = methods[meth_num];
 
-        // Define method offset variable.
+        // Define method offset variable.  Initialize it statically if the
+        // offset is known at compile time.
         char *full_offset_sym = CFCMethod_full_offset_sym(method, client);
-        offsets = CFCUtil_cat(offsets, "uint32_t ", full_offset_sym, ";\n",
-                              NULL);
+        char *offset_const = CFCBindMeth_offset_const(method, client);
+        if (offset_const) {
+            offsets = CFCUtil_cat(offsets, "uint32_t ", full_offset_sym,
+                                  " = ", offset_const, ";\n", NULL);
+        }
+        else {
+            offsets = CFCUtil_cat(offsets, "uint32_t ", full_offset_sym,
+                                  ";\n", NULL);
+        }
+        FREEMEM(offset_const);
         FREEMEM(full_offset_sym);
 
         int is_fresh = CFCMethod_is_fresh(method, client);
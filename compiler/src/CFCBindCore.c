@@ -30,6 +30,7 @@
 #include "CFCHierarchy.h"
 #include "CFCParcel.h"
 #include "CFCUtil.h"
+#include "CFCVariable.h"
 #include "CFCVersion.h"
 
 #define STRING(s)  #s
@@ -41,6 +42,7 @@ struct CFCBindCore {
     char         *c_header;
     char         *c_footer;
     int           charmonic;
+    int           static_vtables;
 };
 
 /* Write the "parcel.h" header file, which contains common symbols needed by
@@ -64,6 +66,12 @@ static void
 S_write_host_data_json(CFCParcel *parcel, const char *dest_dir,
                        const char *host_lang);
 
+/* Mirror the layout of the Class struct, so that method offsets can be
+ * computed at compile time without access to the struct definition.
+ */
+static char*
+S_class_layout(CFCClass **ordered);
+
 static const CFCMeta CFCBINDCORE_META = {
     "Clownfish::CFC::Binding::Core",
     sizeof(CFCBindCore),
@@ -98,6 +106,11 @@ CFCBindCore_destroy(CFCBindCore *self) {
     CFCBase_destroy((CFCBase*)self);
 }
 
+void
+CFCBindCore_set_static_vtables(CFCBindCore *self, int static_vtables) {
+    self->static_vtables = static_vtables;
+}
+
 int
 CFCBindCore_write_all_modified(CFCBindCore *self, int modified) {
     CFCHierarchy *hierarchy = self->hierarchy;
@@ -213,6 +226,16 @@ S_write_parcel_h(CFCBindCore *self, CFCParcel *parcel) {
         "    return cfish_method(dummy->klass, offset);\n"
         "}\n"
         "\n"
+        "/* Return true if the object is an instance of exactly the given class,\n"
+        " * not of a subclass.  Guards direct calls in the wrappers of\n"
+        " * monomorphic methods.\n"
+        " */\n"
+        "static CFISH_INLINE int\n"
+        "cfish_obj_has_class(const void *object, const void *klass) {\n"
+        "    cfish_Dummy *dummy = (cfish_Dummy*)object;\n"
+        "    return dummy->klass == klass;\n"
+        "}\n"
+        "\n"
         "/* Access the function pointer for the given method in the\n"
         " * superclass. */\n"
         "#define CFISH_SUPER_METHOD_PTR(_class, _full_meth) \\\n"
@@ -315,9 +338,11 @@ S_write_parcel_h(CFCBindCore *self, CFCParcel *parcel) {
     char *extra_includes;
     if (CFCParcel_is_cfish(parcel)) {
         const char *spec_typedefs = CFCBindSpecs_get_typedefs();
-        extra_defs = CFCUtil_sprintf("%s%s%s", cfish_defs_1, spec_typedefs,
-                                     cfish_defs_2);
+        char *class_layout = S_class_layout(ordered);
+        extra_defs = CFCUtil_sprintf("%s%s%s%s", cfish_defs_1, spec_typedefs,
+                                     class_layout, cfish_defs_2);
         extra_includes = CFCUtil_strdup(cfish_includes);
+        FREEMEM(class_layout);
     }
     else {
         extra_defs = CFCUtil_strdup("");
@@ -394,6 +419,44 @@ S_write_parcel_h(CFCBindCore *self, CFCParcel *parcel) {
     FREEMEM(file_content);
 }
 
+static char*
+S_class_layout(CFCClass **ordered) {
+    CFCClass *klass = NULL;
+    for (int i = 0; ordered[i] != NULL; i++) {
+        if (strcmp(CFCClass_get_name(ordered[i]), "Clownfish::Class") == 0) {
+            klass = ordered[i];
+            break;
+        }
+    }
+    if (klass == NULL) {
+        CFCUtil_die("Class 'Clownfish::Class' not found");
+    }
+
+    char *member_decs = CFCUtil_strdup("");
+    CFCVariable **member_vars = CFCClass_member_vars(klass);
+    for (int i = 0; member_vars[i] != NULL; i++) {
+        const char *member_dec = CFCVariable_local_declaration(member_vars[i]);
+        member_decs = CFCUtil_cat(member_decs, "    ", member_dec, "\n",
+                                  NULL);
+    }
+
+    const char pattern[] =
+        "/* Layout of the Class struct, used to compute method offsets at\n"
+        " * compile time.\n"
+        " */\n"
+        "typedef struct cfish_ClassLayout {\n"
+        "    CFISH_OBJ_HEAD\n"
+        "%s"
+        "} cfish_ClassLayout;\n"
+        "\n"
+        "#define CFISH_VTABLE_OFFSET offsetof(cfish_ClassLayout, vtable)\n"
+        "\n";
+    char *layout = CFCUtil_sprintf(pattern, member_decs);
+
+    FREEMEM(member_decs);
+    return layout;
+}
+
 static void
 S_write_parcel_c(CFCBindCore *self, CFCParcel *parcel) {
     CFCHierarchy *hierarchy = self->hierarchy;
@@ -403,7 +466,7 @@ S_write_parcel_c(CFCBindCore *self, CFCParcel *parcel) {
     char *privacy_syms = CFCUtil_strdup("");
     char *includes     = CFCUtil_strdup("");
     char *c_data       = CFCUtil_strdup("");
-    CFCBindSpecs *specs = CFCBindSpecs_new();
+    CFCBindSpecs *specs = CFCBindSpecs_new(self->static_vtables);
     CFCClass **ordered = CFCParcel_get_classes(parcel);
 
     for (int i = 0; ordered[i] != NULL; i++) {
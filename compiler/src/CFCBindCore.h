@@ -52,6 +52,13 @@ CFCBindCore_init(CFCBindCore *self, struct CFCHierarchy *hierarchy,
 void
 CFCBindCore_destroy(CFCBindCore *self);
 
+/** If true, emit fully resolved static vtables for classes whose vtable
+ * layout is known at compile time, so that bootstrapping them only copies
+ * function pointers.  Defaults to false.
+ */
+void
+CFCBindCore_set_static_vtables(CFCBindCore *self, int static_vtables);
+
 /** Call `CFCHierarchy_propagate_modified`to establish which
  * classes do not have up-to-date generated .c and .h files, then traverse the
  * hierarchy writing all necessary files.
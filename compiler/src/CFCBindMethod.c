@@ -32,6 +32,16 @@
   #define false 0
 #endif
 
+/* Implementing functions of final and monomorphic methods are exported, so
+ * that they can be called directly from other parcels.
+ */
+static int
+S_imp_is_visible(CFCMethod *method, CFCClass *fresh_class) {
+    return CFCMethod_final(method)
+           || CFCMethod_monomorphic(method)
+           || CFCClass_final(fresh_class);
+}
+
 char*
 CFCBindMeth_method_def(CFCMethod *method, CFCClass *klass) {
     CFCParamList *param_list = CFCMethod_get_param_list(method);
@@ -62,14 +72,48 @@ CFCBindMeth_method_def(CFCMethod *method, CFCClass *klass) {
     // If the method is final and the class where it is declared final is in
     // the same parcel as the invocant, we can optimize the call by resolving
     // to the implementing function directly.
+    //
+    // If the implementing function is exported, code outside the parcel can
+    // opt in to call it directly by defining CFISH_DEVIRTUALIZE.  This ties
+    // the caller to the implementation symbol, so it's not the default.
+    //
+    // Monomorphic methods use the same conditions to guard a direct call for
+    // invocants whose class is exactly `klass`.
     int optimized_final_meth = false;
-    if (CFCMethod_final(method)) {
+    int monomorphic_guard    = false;
+    char *devirt_condition = NULL;
+    if (CFCMethod_final(method)
+        || (CFCMethod_monomorphic(method)
+            && !CFCMethod_abstract(method)
+            && !CFCClass_abstract(klass))
+       ) {
         CFCClass *ancestor = klass;
         while (ancestor && !CFCMethod_is_fresh(method, ancestor)) {
             ancestor = CFCClass_get_parent(ancestor);
         }
+        const char *meth_name = CFCMethod_get_name(method);
+        CFCMethod *fresh_method = CFCClass_method(ancestor, meth_name);
+        int visible = S_imp_is_visible(fresh_method, ancestor);
+        const char *privacy_sym
+            = CFCParcel_get_privacy_sym(CFCClass_get_parcel(klass));
+
         if (CFCClass_in_same_parcel(ancestor, klass)) {
-            optimized_final_meth = true;
+            const char *pattern = visible
+                ? "#if defined(%s) || defined(CFISH_DEVIRTUALIZE)"
+                : "#ifdef %s";
+            devirt_condition = CFCUtil_sprintf(pattern, privacy_sym);
+        }
+        else if (visible) {
+            devirt_condition = CFCUtil_strdup("#ifdef CFISH_DEVIRTUALIZE");
+        }
+
+        if (devirt_condition) {
+            if (CFCMethod_final(method)) {
+                optimized_final_meth = true;
+            }
+            else {
+                monomorphic_guard = true;
+            }
         }
     }
 
@@ -80,41 +124,114 @@ CFCBindMeth_method_def(CFCMethod *method, CFCClass *klass) {
     char *innards = CFCUtil_sprintf(innards_pattern, full_typedef,
                                     full_typedef, self_name, full_offset_sym,
                                     maybe_return, arg_names);
-    if (optimized_final_meth) {
+
+    // Within the parcel, the offset can be folded into the call if the
+    // vtable layout is known at compile time.  It's defined as a constant
+    // which is only visible to the parcel.  Other parcels must load the
+    // offset variable which is initialized by Class_bootstrap.
+    char *offset_const_def = CFCUtil_strdup("");
+    char *offset_const     = CFCBindMeth_offset_const(method, klass);
+    if (offset_const) {
         CFCParcel  *parcel = CFCClass_get_parcel(klass);
         const char *privacy_sym = CFCParcel_get_privacy_sym(parcel);
-        char *invoker_cast = CFCUtil_strdup("");
-        if (!CFCMethod_is_fresh(method, klass)) {
-            CFCType *self_type = CFCMethod_self_type(method);
-            invoker_cast = CFCUtil_cat(invoker_cast, "(",
-                                       CFCType_to_c(self_type), ")", NULL);
+        char *const_sym = CFCUtil_sprintf("%s_CONST", full_offset_sym);
+
+        const char def_pattern[] =
+            "#ifdef %s\n"
+            "  #define %s \\\n"
+            "    (%s)\n"
+            "#endif\n"
+            ;
+        FREEMEM(offset_const_def);
+        offset_const_def = CFCUtil_sprintf(def_pattern, privacy_sym,
+                                           const_sym, offset_const);
+
+        if (!optimized_final_meth) {
+            const char pattern[] =
+                "#ifdef %s\n"
+                "    const %s method = (%s)cfish_obj_method(%s, %s);\n"
+                "#else\n"
+                "    const %s method = (%s)cfish_obj_method(%s, %s);\n"
+                "#endif\n"
+                "    %smethod(%s);\n"
+                ;
+            char *temp = CFCUtil_sprintf(pattern, privacy_sym,
+                                         full_typedef, full_typedef,
+                                         self_name, const_sym,
+                                         full_typedef, full_typedef,
+                                         self_name, full_offset_sym,
+                                         maybe_return, arg_names);
+            FREEMEM(innards);
+            innards = temp;
         }
+
+        FREEMEM(const_sym);
+    }
+    FREEMEM(offset_const);
+
+    char *invoker_cast = CFCUtil_strdup("");
+    if (!CFCMethod_is_fresh(method, klass)) {
+        CFCType *self_type = CFCMethod_self_type(method);
+        invoker_cast = CFCUtil_cat(invoker_cast, "(",
+                                   CFCType_to_c(self_type), ")", NULL);
+    }
+
+    if (optimized_final_meth) {
         const char pattern[] =
-            "#ifdef %s\n"
+            "%s\n"
             "    %s%s(%s%s);\n"
             "#else\n"
             "%s"
             "#endif\n"
             ;
-        char *temp = CFCUtil_sprintf(pattern, privacy_sym,
+        char *temp = CFCUtil_sprintf(pattern, devirt_condition,
                                      maybe_return, full_imp_sym,
                                      invoker_cast, arg_names, innards);
         FREEMEM(innards);
         innards = temp;
-        FREEMEM(invoker_cast);
     }
+    else if (monomorphic_guard) {
+        // Inline cache with a single entry known at compile time: call the
+        // implementing function directly if the invocant is an instance of
+        // exactly `klass`, otherwise fall back to the vtable.
+        const char *class_var = CFCClass_full_class_var(klass);
+        const char *call_pattern = CFCType_is_void(return_type)
+                                   ? "        %s(%s%s);\n"
+                                     "        return;\n"
+                                   : "        return %s(%s%s);\n";
+        char *call = CFCUtil_sprintf(call_pattern, full_imp_sym,
+                                     invoker_cast, arg_names);
+        const char pattern[] =
+            "%s\n"
+            "    if (cfish_obj_has_class(%s, %s)) {\n"
+            "%s"
+            "    }\n"
+            "#endif\n"
+            "%s"
+            ;
+        char *temp = CFCUtil_sprintf(pattern, devirt_condition, self_name,
+                                     class_var, call, innards);
+        FREEMEM(innards);
+        innards = temp;
+        FREEMEM(call);
+    }
+    FREEMEM(invoker_cast);
 
     const char pattern[] =
         "extern %sVISIBLE uint32_t %s;\n"
+        "%s"
         "static CFISH_INLINE %s\n"
         "%s(%s%s) {\n"
         "%s"
         "}\n";
     char *method_def
-        = CFCUtil_sprintf(pattern, PREFIX, full_offset_sym, ret_type_str,
-                          full_meth_sym, invoker_struct, params_end, innards);
+        = CFCUtil_sprintf(pattern, PREFIX, full_offset_sym, offset_const_def,
+                          ret_type_str, full_meth_sym, invoker_struct,
+                          params_end, innards);
 
+    FREEMEM(offset_const_def);
     FREEMEM(innards);
+    FREEMEM(devirt_condition);
     FREEMEM(full_imp_sym);
     FREEMEM(full_offset_sym);
     FREEMEM(full_meth_sym);
@@ -139,6 +256,31 @@ CFCBindMeth_typedef_dec(struct CFCMethod *method, CFCClass *klass) {
     return buf;
 }
 
+char*
+CFCBindMeth_offset_const(CFCMethod *method, CFCClass *klass) {
+    // If ancestors live in other parcels, the layout of their part of the
+    // vtable can only be relied upon if the parcel opted in to constant
+    // offsets, accepting to be rebuilt whenever a prerequisite changes.
+    CFCParcel *parcel = CFCClass_get_parcel(klass);
+    if (!CFCClass_fixed_vtable(klass) && !CFCParcel_const_offsets(parcel)) {
+        return NULL;
+    }
+
+    // Methods are stored in vtable order.
+    const char *meth_name = CFCMethod_get_name(method);
+    CFCMethod **methods = CFCClass_methods(klass);
+    for (int i = 0; methods[i] != NULL; i++) {
+        if (strcmp(CFCMethod_get_name(methods[i]), meth_name) == 0) {
+            return CFCUtil_sprintf("(uint32_t)(CFISH_VTABLE_OFFSET + %d"
+                                   " * sizeof(cfish_method_t))", i);
+        }
+    }
+
+    CFCUtil_die("Method '%s' not found in '%s'", meth_name,
+                CFCClass_get_name(klass));
+    return NULL;
+}
+
 char*
 CFCBindMeth_abstract_method_def(CFCMethod *method, CFCClass *klass) {
     CFCType    *ret_type      = CFCMethod_get_return_type(method);
@@ -198,8 +340,16 @@ CFCBindMeth_imp_declaration(CFCMethod *method, CFCClass *klass) {
     const char   *param_list_str = CFCParamList_to_c(param_list);
 
     char *full_imp_sym = CFCMethod_imp_func(method, klass);
-    char *buf = CFCUtil_sprintf("%s\n%s(%s);", ret_type_str,
-                                full_imp_sym, param_list_str);
+    char *buf;
+    if (S_imp_is_visible(method, klass)) {
+        const char *PREFIX = CFCClass_get_PREFIX(klass);
+        buf = CFCUtil_sprintf("%sVISIBLE %s\n%s(%s);", PREFIX, ret_type_str,
+                              full_imp_sym, param_list_str);
+    }
+    else {
+        buf = CFCUtil_sprintf("%s\n%s(%s);", ret_type_str, full_imp_sym,
+                              param_list_str);
+    }
 
     FREEMEM(full_imp_sym);
     return buf;
@@ -44,6 +44,15 @@ CFCBindMeth_method_def(struct CFCMethod *method, struct CFCClass *klass);
 char*
 CFCBindMeth_typedef_dec(struct CFCMethod *method, struct CFCClass *klass);
 
+/** Return a C constant expression for the offset of the method in the
+ * vtable of `klass`, or NULL if the offset isn't known when the parcel is
+ * compiled.  This is the case if one of the ancestors of `klass` belongs to
+ * another parcel, unless constant offsets were enabled for the parcel of
+ * `klass` with CFCParcel_set_const_offsets.
+ */
+char*
+CFCBindMeth_offset_const(struct CFCMethod *method, struct CFCClass *klass);
+
 /** Return C code implementing a version of the method which throws an
  * "abstract method" error at runtime, for methods which are declared as
  * "abstract" in a Clownfish header file.
@@ -32,12 +32,15 @@ struct CFCBindSpecs {
     char *overridden_specs;
     char *inherited_specs;
     char *class_specs;
+    char *vtables;
     char *init_code;
 
     int num_novel;
     int num_overridden;
     int num_inherited;
     int num_specs;
+
+    int static_vtables;
 };
 
 static char*
@@ -59,6 +62,9 @@ static void
 S_add_inherited_meth(CFCBindSpecs *self, CFCMethod *method, CFCClass *klass,
                      int meth_index);
 
+static char*
+S_add_vtable(CFCBindSpecs *self, CFCClass *klass);
+
 static const CFCMeta CFCBINDSPECS_META = {
     "Clownfish::CFC::Binding::Core::Specs",
     sizeof(CFCBindSpecs),
@@ -66,18 +72,20 @@ static const CFCMeta CFCBINDSPECS_META = {
 };
 
 CFCBindSpecs*
-CFCBindSpecs_new() {
+CFCBindSpecs_new(int static_vtables) {
     CFCBindSpecs *self = (CFCBindSpecs*)CFCBase_allocate(&CFCBINDSPECS_META);
-    return CFCBindSpecs_init(self);
+    return CFCBindSpecs_init(self, static_vtables);
 }
 
 CFCBindSpecs*
-CFCBindSpecs_init(CFCBindSpecs *self) {
+CFCBindSpecs_init(CFCBindSpecs *self, int static_vtables) {
     self->novel_specs      = CFCUtil_strdup("");
     self->overridden_specs = CFCUtil_strdup("");
     self->inherited_specs  = CFCUtil_strdup("");
     self->class_specs      = CFCUtil_strdup("");
+    self->vtables          = CFCUtil_strdup("");
     self->init_code        = CFCUtil_strdup("");
+    self->static_vtables   = static_vtables;
 
     return self;
 }
@@ -88,6 +96,7 @@ CFCBindSpecs_destroy(CFCBindSpecs *self) {
     FREEMEM(self->overridden_specs);
     FREEMEM(self->inherited_specs);
     FREEMEM(self->class_specs);
+    FREEMEM(self->vtables);
     FREEMEM(self->init_code);
     CFCBase_destroy((CFCBase*)self);
 }
@@ -130,6 +139,7 @@ CFCBindSpecs_get_typedefs() {
         "    uint32_t      num_overridden_meths;\n"
         "    uint32_t      num_inherited_meths;\n"
         "    uint32_t      flags;\n"
+        "    const cfish_method_t *vtable;\n"
         "} cfish_ClassSpec;\n"
         "\n"
         "typedef struct cfish_ParcelSpec {\n"
@@ -206,6 +216,8 @@ CFCBindSpecs_add_class(CFCBindSpecs *self, CFCClass *klass) {
         }
     }
 
+    char *vtable = S_add_vtable(self, klass);
+
     char pattern[] =
         "    {\n"
         "        &%s, /* class */\n"
@@ -216,12 +228,14 @@ CFCBindSpecs_add_class(CFCBindSpecs *self, CFCClass *klass) {
         "        %d, /* num_novel */\n"
         "        %d, /* num_overridden */\n"
         "        %d, /* num_inherited */\n"
-        "        %s /* flags */\n"
+        "        %s, /* flags */\n"
+        "        %s /* vtable */\n"
         "    }";
     char *class_spec
         = CFCUtil_sprintf(pattern, class_var, parent_ptr, class_name,
                           ivars_size, ivars_offset_name, num_new_novel,
-                          num_new_overridden, num_new_inherited, flags);
+                          num_new_overridden, num_new_inherited, flags,
+                          vtable);
 
     const char *sep = self->num_specs == 0 ? "" : ",\n";
     self->class_specs = CFCUtil_cat(self->class_specs, sep, class_spec, NULL);
@@ -232,6 +246,7 @@ CFCBindSpecs_add_class(CFCBindSpecs *self, CFCClass *klass) {
     self->num_specs      += 1;
 
     FREEMEM(class_spec);
+    FREEMEM(vtable);
     FREEMEM(parent_ptr);
     FREEMEM(ivars_size);
 }
@@ -273,6 +288,7 @@ CFCBindSpecs_defs(CFCBindSpecs *self) {
         "%s"
         "%s"
         "%s"
+        "%s"
         "static cfish_ClassSpec class_specs[] = {\n"
         "%s\n"
         "};\n"
@@ -285,8 +301,8 @@ CFCBindSpecs_defs(CFCBindSpecs *self) {
         "    %d\n" // num_classes
         "};\n";
     char *defs = CFCUtil_sprintf(pattern, novel_specs, overridden_specs,
-                                 inherited_specs, self->class_specs,
-                                 self->num_specs);
+                                 inherited_specs, self->vtables,
+                                 self->class_specs, self->num_specs);
 
     FREEMEM(inherited_specs);
     FREEMEM(overridden_specs);
@@ -446,3 +462,36 @@ S_add_inherited_meth(CFCBindSpecs *self, CFCMethod *method, CFCClass *klass,
     FREEMEM(parent_offset);
 }
 
+
+// If enabled, define a fully resolved vtable for classes whose layout is
+// known at compile time.  Return the expression for the ClassSpec.
+static char*
+S_add_vtable(CFCBindSpecs *self, CFCClass *klass) {
+    if (!self->static_vtables || !CFCClass_fixed_vtable(klass)) {
+        return CFCUtil_strdup("NULL");
+    }
+
+    const char *class_var = CFCClass_full_class_var(klass);
+    char *entries = CFCUtil_strdup("");
+    CFCMethod **methods = CFCClass_methods(klass);
+
+    for (int meth_num = 0; methods[meth_num] != NULL; meth_num++) {
+        char *imp_func = CFCMethod_imp_func(methods[meth_num], klass);
+        const char *sep = meth_num == 0 ? "" : ",\n";
+        entries = CFCUtil_cat(entries, sep, "    (cfish_method_t)", imp_func,
+                              NULL);
+        FREEMEM(imp_func);
+    }
+
+    const char pattern[] =
+        "static const cfish_method_t %s_VTABLE[] = {\n"
+        "%s\n"
+        "};\n"
+        "\n";
+    char *vtable = CFCUtil_sprintf(pattern, class_var, entries);
+    self->vtables = CFCUtil_cat(self->vtables, vtable, NULL);
+
+    FREEMEM(vtable);
+    FREEMEM(entries);
+    return CFCUtil_sprintf("%s_VTABLE", class_var);
+}
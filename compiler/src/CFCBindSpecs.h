@@ -29,11 +29,16 @@ typedef struct CFCBindSpecs CFCBindSpecs;
 
 struct CFCClass;
 
+/**
+ * @param static_vtables If true, define fully resolved vtables for classes
+ * whose vtable layout is known at compile time.  Class_bootstrap copies
+ * these vtables instead of assembling them from the method specs.
+ */
 CFCBindSpecs*
-CFCBindSpecs_new(void);
+CFCBindSpecs_new(int static_vtables);
 
 CFCBindSpecs*
-CFCBindSpecs_init(CFCBindSpecs *specs);
+CFCBindSpecs_init(CFCBindSpecs *specs, int static_vtables);
 
 void
 CFCBindSpecs_destroy(CFCBindSpecs *specs);
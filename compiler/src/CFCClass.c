@@ -738,6 +738,17 @@ CFCClass_in_same_parcel(CFCClass *self, CFCClass *other) {
     return CFCClass_get_parcel(self) == CFCClass_get_parcel(other);
 }
 
+int
+CFCClass_fixed_vtable(CFCClass *self) {
+    for (CFCClass *ancestor = CFCClass_get_parent(self);
+         ancestor != NULL;
+         ancestor = CFCClass_get_parent(ancestor)
+        ) {
+        if (!CFCClass_in_same_parcel(ancestor, self)) { return false; }
+    }
+    return true;
+}
+
 const char*
 CFCClass_get_struct_sym(CFCClass *self) {
     return self->struct_sym;
@@ -230,6 +230,13 @@ CFCClass_in_parcel(CFCClass *self, struct CFCParcel *parcel);
 int
 CFCClass_in_same_parcel(CFCClass *self, CFCClass *other);
 
+/** Return true if the layout of the class's vtable is fixed when its parcel
+ * is compiled.  This is the case if the class and all of its ancestors
+ * belong to the same parcel.
+ */
+int
+CFCClass_fixed_vtable(CFCClass *self);
+
 const char*
 CFCClass_get_struct_sym(CFCClass *self);
 
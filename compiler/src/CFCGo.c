@@ -168,20 +168,48 @@ S_register_classes(CFCParcel *parcel) {
     }
 }
 
+// C shims which let method glue pass Go strings without copying them.
+static char*
+S_gen_borrow_shims(CFCParcel *parcel) {
+    CFCGoClass **registry = CFCGoClass_registry();
+    char *shims = CFCUtil_strdup("");
+    for (int i = 0; registry[i] != NULL; i++) {
+        CFCGoClass *class_binding = registry[i];
+        CFCClass *client = CFCGoClass_get_client(class_binding);
+        if (!CFCClass_in_parcel(client, parcel)) {
+            continue;
+        }
+        char *class_shims = CFCGoClass_gen_borrow_shims(class_binding);
+        shims = CFCUtil_cat(shims, class_shims, NULL);
+        FREEMEM(class_shims);
+    }
+    if (shims[0] != '\0') {
+        char *temp = CFCUtil_sprintf("#include \"Clownfish/String.h\"\n\n%s",
+                                     shims);
+        FREEMEM(shims);
+        shims = temp;
+    }
+    return shims;
+}
+
 static char*
 S_gen_cgo_comment(CFCGo *self, CFCParcel *parcel, const char *h_includes) {
     CHY_UNUSED_VAR(self);
-    const char *prefix = CFCParcel_get_prefix(parcel);
     // Bake in parcel privacy define, so that binding code can be compiled
     // without extra compiler flags.
     const char *privacy_sym = CFCParcel_get_privacy_sym(parcel);
+    char *borrow_shims = S_gen_borrow_shims(parcel);
     char pattern[] =
         "#define %s\n"
         "\n"
         "%s\n"
+        "%s"
         "\n"
         ;
-    return CFCUtil_sprintf(pattern, privacy_sym, h_includes, prefix);
+    char *comment = CFCUtil_sprintf(pattern, privacy_sym, h_includes,
+                                    borrow_shims);
+    FREEMEM(borrow_shims);
+    return comment;
 }
 
 static char*
@@ -372,6 +372,21 @@ CFCGoClass_gen_meth_glue(CFCGoClass *self) {
     return meth_defs;
 }
 
+char*
+CFCGoClass_gen_borrow_shims(CFCGoClass *self) {
+    S_lazy_init_method_bindings(self);
+    char *shims = CFCUtil_strdup("");
+    for (size_t i = 0; self->method_bindings[i] != NULL; i++) {
+        CFCGoMethod *meth_binding = self->method_bindings[i];
+        char *shim = CFCGoMethod_borrow_shim(meth_binding, self->client);
+        if (shim[0] != '\0') {
+            shims = CFCUtil_cat(shims, shim, "\n", NULL);
+        }
+        FREEMEM(shim);
+    }
+    return shims;
+}
+
 char*
 CFCGoClass_gen_wrap_func_reg(CFCGoClass *self) {
     if (CFCClass_inert(self->client)) {
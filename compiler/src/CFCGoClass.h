@@ -76,6 +76,11 @@ CFCGoClass_gen_ctors(CFCGoClass *self);
 char*
 CFCGoClass_gen_meth_glue(CFCGoClass *self);
 
+/** Return the C shims for the cgo preamble needed by the method glue.
+ */
+char*
+CFCGoClass_gen_borrow_shims(CFCGoClass *self);
+
 char*
 CFCGoClass_gen_wrap_func_reg(CFCGoClass *self);
 
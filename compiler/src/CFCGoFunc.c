@@ -58,6 +58,13 @@ CFCGoFunc_go_meth_name(const char *orig, int is_public) {
     return go_name;
 }
 
+int
+CFCGoFunc_borrows_string(CFCType *type) {
+    // A String which isn't decremented doesn't outlive the call, unless the
+    // callee increfs it -- which copies a wrapped String.
+    return CFCType_cfish_string(type) && !CFCType_decremented(type);
+}
+
 static char*
 S_prep_start(CFCParcel *parcel, const char *name, CFCClass *invoker,
              CFCParamList *param_list, CFCType *return_type, int targ) {
@@ -122,6 +129,17 @@ S_prep_start(CFCParcel *parcel, const char *name, CFCClass *invoker,
             nullable = true;
         }
 
+        if (targ == IS_METHOD && i > 0 && CFCGoFunc_borrows_string(type)) {
+            // Pass the bytes of the Go string instead of copying them.  cgo
+            // keeps them in place for the duration of the call.
+            char pattern[] = "\t%sCF := (*C.char)(%sBorrowStringData(%s))\n";
+            char *conversion = CFCUtil_sprintf(pattern, go_name,
+                                               clownfish_dot, go_name);
+            converted = CFCUtil_cat(converted, conversion, NULL);
+            FREEMEM(conversion);
+            continue;
+        }
+
         const char *class_var = NULL;
         const char *struct_name = CFCType_get_specifier(type);
         if (CFCType_cfish_obj(type)) {
@@ -250,6 +268,12 @@ S_prep_cfargs(CFCParcel *parcel, CFCClass *invoker,
             cfargs = CFCUtil_cat(cfargs, "C.", CFCType_get_specifier(type),
                                  "(", go_name, ")", NULL);
         }
+        else if (targ == IS_METHOD && i > 0
+                 && CFCGoFunc_borrows_string(type)
+                ) {
+            cfargs = CFCUtil_cat(cfargs, go_name, "CF, C.size_t(len(",
+                                 go_name, "))", NULL);
+        }
         else if (CFCType_is_object(type)) {
             cfargs = CFCUtil_cat(cfargs, go_name, "CF", NULL);
         }
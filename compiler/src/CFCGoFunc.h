@@ -42,6 +42,13 @@ CFCGoFunc_ctor_start(struct CFCParcel *parcel, const char *name,
                      struct CFCParamList *param_list,
                      struct CFCType *return_type);
 
+/** Return true if a method argument of type `type` is passed to C as a
+ * pointer to the bytes of the Go string plus a length, to be wrapped in a
+ * stack String by a C shim.
+ */
+int
+CFCGoFunc_borrows_string(struct CFCType *type);
+
 /** Convert Go method arguments to comma-separated Clownfish-flavored C
  * arguments, to be passed to a Clownfish method.
  */
@@ -133,6 +133,34 @@ CFCGoMethod_get_sig(CFCGoMethod *self, CFCClass *invoker) {
     }
 }
 
+// Name of the C function which the Go method glue invokes.
+static char*
+S_cfunc(CFCGoMethod *self, CFCClass *invoker) {
+    CFCMethod *novel_method = CFCMethod_find_novel_method(self->method);
+    if (CFCMethod_novel(self->method) && CFCMethod_final(self->method)) {
+        return CFCUtil_strdup(CFCMethod_imp_func(self->method, invoker));
+    }
+    else {
+        return CFCMethod_full_method_sym(novel_method, invoker);
+    }
+}
+
+static int
+S_borrows_strings(CFCParamList *param_list) {
+    CFCVariable **vars = CFCParamList_get_variables(param_list);
+    for (int i = 1; vars[i] != NULL; i++) {
+        if (CFCGoFunc_borrows_string(CFCVariable_get_type(vars[i]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static char*
+S_borrow_shim_name(const char *cfunc) {
+    return CFCUtil_sprintf("GoCfish_borrow_%s", cfunc);
+}
+
 char*
 CFCGoMethod_func_def(CFCGoMethod *self, CFCClass *invoker) {
     if (!self->method || CFCMethod_excluded_from_host(self->method)) {
@@ -147,12 +175,11 @@ CFCGoMethod_func_def(CFCGoMethod *self, CFCClass *invoker) {
                                         CFCMethod_public(novel_method));
     char *first_line = CFCGoFunc_meth_start(parcel, name, invoker,
                                             param_list, ret_type);
-    char *cfunc;
-    if (CFCMethod_novel(self->method) && CFCMethod_final(self->method)) {
-        cfunc = CFCUtil_strdup(CFCMethod_imp_func(self->method, invoker));
-    }
-    else {
-        cfunc = CFCMethod_full_method_sym(novel_method, invoker);
+    char *cfunc = S_cfunc(self, invoker);
+    if (S_borrows_strings(param_list)) {
+        char *shim_name = S_borrow_shim_name(cfunc);
+        FREEMEM(cfunc);
+        cfunc = shim_name;
     }
 
     char *cfargs = CFCGoFunc_meth_cfargs(parcel, invoker, param_list);
@@ -187,3 +214,65 @@ CFCGoMethod_func_def(CFCGoMethod *self, CFCClass *invoker) {
     return content;
 }
 
+
+char*
+CFCGoMethod_borrow_shim(CFCGoMethod *self, CFCClass *invoker) {
+    if (!self->method || CFCMethod_excluded_from_host(self->method)) {
+        return CFCUtil_strdup("");
+    }
+
+    CFCMethod    *novel_method = CFCMethod_find_novel_method(self->method);
+    CFCParamList *param_list = CFCMethod_get_param_list(novel_method);
+    if (!S_borrows_strings(param_list)) {
+        return CFCUtil_strdup("");
+    }
+
+    CFCType *ret_type  = CFCMethod_get_return_type(novel_method);
+    char    *cfunc     = S_cfunc(self, invoker);
+    char    *shim_name = S_borrow_shim_name(cfunc);
+
+    // The stack Strings live in the shim's frame, so they must be created
+    // by the same cgo call which invokes the method.
+    CFCVariable **vars = CFCParamList_get_variables(param_list);
+    char *params  = CFCUtil_strdup("");
+    char *wrapped = CFCUtil_strdup("");
+    char *args    = CFCUtil_strdup("");
+    for (int i = 0; vars[i] != NULL; i++) {
+        CFCType    *type = CFCVariable_get_type(vars[i]);
+        const char *name = CFCVariable_get_name(vars[i]);
+        if (i > 0) {
+            params = CFCUtil_cat(params, ", ", NULL);
+            args   = CFCUtil_cat(args, ", ", NULL);
+        }
+        if (i > 0 && CFCGoFunc_borrows_string(type)) {
+            params = CFCUtil_cat(params, "const char *", name, "_ptr, size_t ",
+                                 name, "_len", NULL);
+            wrapped = CFCUtil_cat(wrapped, "    cfish_String *", name,
+                                  " = CFISH_SSTR_WRAP_UTF8(", name, "_ptr, ",
+                                  name, "_len);\n", NULL);
+        }
+        else {
+            params = CFCUtil_cat(params, CFCType_to_c(type), " ", name, NULL);
+        }
+        args = CFCUtil_cat(args, name, NULL);
+    }
+
+    char pattern[] =
+        "static CFISH_INLINE %s\n"
+        "%s(%s) {\n"
+        "%s"
+        "    %s%s(%s);\n"
+        "}\n"
+        ;
+    const char *maybe_return = CFCType_is_void(ret_type) ? "" : "return ";
+    char *content = CFCUtil_sprintf(pattern, CFCType_to_c(ret_type),
+                                    shim_name, params, wrapped, maybe_return,
+                                    cfunc, args);
+
+    FREEMEM(args);
+    FREEMEM(wrapped);
+    FREEMEM(params);
+    FREEMEM(shim_name);
+    FREEMEM(cfunc);
+    return content;
+}
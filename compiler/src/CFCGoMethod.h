@@ -49,6 +49,13 @@ CFCGoMethod_get_sig(CFCGoMethod *self, struct CFCClass *invoker);
 char*
 CFCGoMethod_func_def(CFCGoMethod *self, struct CFCClass *invoker);
 
+/** Return a static inline C function for the cgo preamble which wraps
+ * borrowed Go string data in stack Strings and invokes the method, or an
+ * empty string if the method has no such arguments.
+ */
+char*
+CFCGoMethod_borrow_shim(CFCGoMethod *self, struct CFCClass *invoker);
+
 #ifdef __cplusplus
 }
 #endif
@@ -600,6 +600,7 @@ char *yytext;
         {"int64_t", CFC_TOKENTYPE_INTEGER_TYPE_NAME },
         {"int8_t", CFC_TOKENTYPE_INTEGER_TYPE_NAME },
         {"long", CFC_TOKENTYPE_INTEGER_TYPE_NAME },
+        {"monomorphic", CFC_TOKENTYPE_MONOMORPHIC },
         {"nickname", CFC_TOKENTYPE_NICKNAME },
         {"nullable", CFC_TOKENTYPE_NULLABLE },
         {"parcel", CFC_TOKENTYPE_PARCEL },
@@ -40,8 +40,10 @@ struct CFCMethod {
     char *host_alias;
     int is_final;
     int is_abstract;
+    int is_monomorphic;
     int is_novel;
     int is_excluded;
+    int is_fast_callback;
 };
 
 static CFCClass*
@@ -118,12 +120,14 @@ CFCMethod_init(CFCMethod *self, const char *exposure, const char *name,
         }
     }
 
-    self->novel_method = NULL;
-    self->fresh_class  = CFCWeakPtr_new((CFCBase*)klass);
-    self->host_alias   = NULL;
-    self->is_final     = is_final;
-    self->is_abstract  = is_abstract;
-    self->is_excluded  = false;
+    self->novel_method   = NULL;
+    self->fresh_class    = CFCWeakPtr_new((CFCBase*)klass);
+    self->host_alias     = NULL;
+    self->is_final       = is_final;
+    self->is_abstract    = is_abstract;
+    self->is_monomorphic = false;
+    self->is_excluded    = false;
+    self->is_fast_callback = false;
 
     // Assume that this method is novel until we discover when applying
     // inheritance that it overrides another.
@@ -235,6 +239,7 @@ CFCMethod_finalize(CFCMethod *self) {
                         self->callable.param_list,
                         self->callable.docucomment,
                         S_fresh_class(self), true, self->is_abstract);
+    finalized->is_monomorphic = self->is_monomorphic;
     finalized->novel_method
         = (CFCMethod*)CFCBase_incref((CFCBase*)self->novel_method);
     finalized->is_novel = self->is_novel;
@@ -323,6 +328,22 @@ CFCMethod_excluded_from_host(CFCMethod *self) {
     return novel_method->is_excluded;
 }
 
+void
+CFCMethod_set_fast_callback(CFCMethod *self) {
+    if (!self->is_novel) {
+        const char *name = CFCMethod_get_name(self);
+        CFCUtil_die("Can't set_fast_callback -- method %s not novel in %s",
+                    name, S_fresh_class_name(self));
+    }
+    self->is_fast_callback = true;
+}
+
+int
+CFCMethod_fast_callback(CFCMethod *self) {
+    CFCMethod *novel_method = CFCMethod_find_novel_method(self);
+    return novel_method->is_fast_callback;
+}
+
 CFCMethod*
 CFCMethod_find_novel_method(CFCMethod *self) {
     if (self->is_novel) {
@@ -396,6 +417,16 @@ CFCMethod_abstract(CFCMethod *self) {
     return self->is_abstract;
 }
 
+void
+CFCMethod_set_monomorphic(CFCMethod *self, int is_monomorphic) {
+    self->is_monomorphic = !!is_monomorphic;
+}
+
+int
+CFCMethod_monomorphic(CFCMethod *self) {
+    return self->is_monomorphic;
+}
+
 int
 CFCMethod_novel(CFCMethod *self) {
     return self->is_novel;
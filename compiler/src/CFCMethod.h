@@ -184,6 +184,18 @@ CFCMethod_final(CFCMethod *self);
 int
 CFCMethod_abstract(CFCMethod *self);
 
+/** Mark the method as "monomorphic": calls are expected to be made almost
+ * exclusively on instances of a single class.  The generated method wrapper
+ * compares the class of the invocant against the invoking class and calls
+ * the implementing function directly on a match, falling back to vtable
+ * dispatch otherwise.
+ */
+void
+CFCMethod_set_monomorphic(CFCMethod *self, int is_monomorphic);
+
+int
+CFCMethod_monomorphic(CFCMethod *self);
+
 /** Returns true if this method is the first implemenation in the inheritance
  * hierarchy in which the method was declared.
  */
@@ -208,6 +220,16 @@ CFCMethod_exclude_from_host(CFCMethod *self);
 int
 CFCMethod_excluded_from_host(CFCMethod *self);
 
+/** Make host callbacks for the method resolve the host override once per
+ * class and pass arguments positionally.  Only affects host languages which
+ * support it.
+ */
+void
+CFCMethod_set_fast_callback(CFCMethod *self);
+
+int
+CFCMethod_fast_callback(CFCMethod *self);
+
 const char*
 CFCMethod_get_exposure(CFCMethod *self);
 
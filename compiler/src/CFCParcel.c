@@ -44,6 +44,7 @@ struct CFCParcel {
     char *PREFIX;
     char *privacy_sym;
     int is_installed;
+    int const_offsets;
     CFCClass **classes;
     size_t num_classes;
     CFCPrereq **prereqs;
@@ -210,7 +211,8 @@ CFCParcel_init(CFCParcel *self, const char *name, const char *nickname,
     self->privacy_sym[privacy_sym_len] = '\0';
 
     // Initialize flags.
-    self->is_installed = false;
+    self->is_installed  = false;
+    self->const_offsets = false;
 
     // Initialize arrays.
     self->classes = (CFCClass**)CALLOCATE(1, sizeof(CFCClass*));
@@ -430,6 +432,16 @@ CFCParcel_set_installed(CFCParcel *self, int is_installed) {
     self->is_installed = is_installed;
 }
 
+int
+CFCParcel_const_offsets(CFCParcel *self) {
+    return self->const_offsets;
+}
+
+void
+CFCParcel_set_const_offsets(CFCParcel *self, int const_offsets) {
+    self->const_offsets = const_offsets;
+}
+
 CFCVersion*
 CFCParcel_get_version(CFCParcel *self) {
     return self->version;
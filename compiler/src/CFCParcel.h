@@ -103,6 +103,16 @@ CFCParcel_is_installed(CFCParcel *self);
 void
 CFCParcel_set_installed(CFCParcel *self, int is_installed);
 
+/** Return true if code in the parcel uses compile-time constants for the
+ * method offsets of classes with ancestors in prerequisite parcels.  This
+ * ties the parcel to the exact vtable layout of its prerequisites.
+ */
+int
+CFCParcel_const_offsets(CFCParcel *self);
+
+void
+CFCParcel_set_const_offsets(CFCParcel *self, int const_offsets);
+
 struct CFCVersion*
 CFCParcel_get_version(CFCParcel *self);
 
@@ -42,7 +42,7 @@ S_start_class(CFCParser *state, CFCDocuComment *docucomment, char *exposure,
     int is_inert = false;
     int is_abstract = false;
     if (modifiers) {
-        if (strstr(modifiers, "inline")) {
+        if (strstr(modifiers, "inline") || strstr(modifiers, "monomorphic")) {
             CFCUtil_die("Illegal class modifiers: '%s'", modifiers);
         }
         is_final = !!strstr(modifiers, "final");
@@ -81,15 +81,17 @@ S_new_sub(CFCParser *state, CFCDocuComment *docucomment,
           char *exposure, char *modifiers, CFCType *type, char *name,
           CFCParamList *param_list) {
     /* Find modifiers by scanning the list. */
-    int is_abstract = false;
-    int is_final    = false;
-    int is_inline   = false;
-    int is_inert    = false;
+    int is_abstract    = false;
+    int is_final       = false;
+    int is_inline      = false;
+    int is_inert       = false;
+    int is_monomorphic = false;
     if (modifiers) {
-        is_abstract = !!strstr(modifiers, "abstract");
-        is_final    = !!strstr(modifiers, "final");
-        is_inline   = !!strstr(modifiers, "inline");
-        is_inert    = !!strstr(modifiers, "inert");
+        is_abstract    = !!strstr(modifiers, "abstract");
+        is_final       = !!strstr(modifiers, "final");
+        is_inline      = !!strstr(modifiers, "inline");
+        is_inert       = !!strstr(modifiers, "inert");
+        is_monomorphic = !!strstr(modifiers, "monomorphic");
     }
     CFCClass *klass = CFCParser_get_class(state);
     if (CFCClass_final(klass) && !is_inert) {
@@ -105,6 +107,9 @@ S_new_sub(CFCParser *state, CFCDocuComment *docucomment,
         if (is_final) {
             CFCUtil_die("Inert functions must not be final");
         }
+        if (is_monomorphic) {
+            CFCUtil_die("Inert functions must not be monomorphic");
+        }
         sub = (CFCBase*)CFCFunction_new(exposure, name, type, param_list,
                                         docucomment, is_inline);
     }
@@ -116,6 +121,9 @@ S_new_sub(CFCParser *state, CFCDocuComment *docucomment,
         sub = (CFCBase*)CFCMethod_new(exposure, name, type, param_list,
                                       docucomment, klass, is_final,
                                       is_abstract);
+        if (is_monomorphic) {
+            CFCMethod_set_monomorphic((CFCMethod*)sub, true);
+        }
     }
 
     /* Consume tokens. */
@@ -524,6 +532,7 @@ declaration_modifier(A) ::= INERT(B).      { A = B; }
 declaration_modifier(A) ::= INLINE(B).     { A = B; }
 declaration_modifier(A) ::= ABSTRACT(B).   { A = B; }
 declaration_modifier(A) ::= FINAL(B).      { A = B; }
+declaration_modifier(A) ::= MONOMORPHIC(B). { A = B; }
 
 declaration_modifier_list(A) ::= declaration_modifier(B). { A = B; }
 declaration_modifier_list(A) ::= declaration_modifier_list(B) declaration_modifier(C).
@@ -364,9 +364,19 @@ S_write_host_c(CFCPerl *self, CFCParcel *parcel) {
         "#include \"perl.h\"\n"
         "#include \"XSUB.h\"\n"
         "\n"
+        "/* Fast callbacks pass the cached CV of the override.  Otherwise, the\n"
+        " * method is looked up by name.\n"
+        " */\n"
+        "static CFISH_INLINE int\n"
+        "SI_call_method(pTHX_ CV *cv, const char *meth_name, I32 flags) {\n"
+        "    return cv ? call_sv((SV*)cv, flags)\n"
+        "              : call_method(meth_name, flags);\n"
+        "}\n"
+        "\n"
         "static void\n"
-        "S_finish_callback_void(pTHX_ const char *meth_name) {\n"
-        "    int count = call_method(meth_name, G_VOID | G_DISCARD);\n"
+        "S_finish_callback_void(pTHX_ CV *cv, const char *meth_name) {\n"
+        "    int count = SI_call_method(aTHX_ cv, meth_name,\n"
+        "                               G_VOID | G_DISCARD);\n"
         "    if (count != 0) {\n"
         "        CFISH_THROW(CFISH_ERR, \"Bad callback to '%%s': %%i32\",\n"
         "                    meth_name, (int32_t)count);\n"
@@ -376,8 +386,8 @@ S_write_host_c(CFCPerl *self, CFCParcel *parcel) {
         "}\n"
         "\n"
         "static CFISH_INLINE SV*\n"
-        "SI_do_callback_sv(pTHX_ const char *meth_name) {\n"
-        "    int count = call_method(meth_name, G_SCALAR);\n"
+        "SI_do_callback_sv(pTHX_ CV *cv, const char *meth_name) {\n"
+        "    int count = SI_call_method(aTHX_ cv, meth_name, G_SCALAR);\n"
         "    if (count != 1) {\n"
         "        CFISH_THROW(CFISH_ERR, \"Bad callback to '%%s': %%i32\",\n"
         "                    meth_name, (int32_t)count);\n"
@@ -389,8 +399,8 @@ S_write_host_c(CFCPerl *self, CFCParcel *parcel) {
         "}\n"
         "\n"
         "static int64_t\n"
-        "S_finish_callback_i64(pTHX_ const char *meth_name) {\n"
-        "    SV *return_sv = SI_do_callback_sv(aTHX_ meth_name);\n"
+        "S_finish_callback_i64(pTHX_ CV *cv, const char *meth_name) {\n"
+        "    SV *return_sv = SI_do_callback_sv(aTHX_ cv, meth_name);\n"
         "    int64_t retval;\n"
         "    if (sizeof(IV) == 8) {\n"
         "        retval = (int64_t)SvIV(return_sv);\n"
@@ -412,8 +422,8 @@ S_write_host_c(CFCPerl *self, CFCParcel *parcel) {
         "}\n"
         "\n"
         "static double\n"
-        "S_finish_callback_f64(pTHX_ const char *meth_name) {\n"
-        "    SV *return_sv = SI_do_callback_sv(aTHX_ meth_name);\n"
+        "S_finish_callback_f64(pTHX_ CV *cv, const char *meth_name) {\n"
+        "    SV *return_sv = SI_do_callback_sv(aTHX_ cv, meth_name);\n"
         "    double retval = SvNV(return_sv);\n"
         "    FREETMPS;\n"
         "    LEAVE;\n"
@@ -421,9 +431,9 @@ S_write_host_c(CFCPerl *self, CFCParcel *parcel) {
         "}\n"
         "\n"
         "static cfish_Obj*\n"
-        "S_finish_callback_obj(pTHX_ void *vself, const char *meth_name,\n"
+        "S_finish_callback_obj(pTHX_ void *vself, CV *cv, const char *meth_name,\n"
         "                      int nullable) {\n"
-        "    SV *return_sv = SI_do_callback_sv(aTHX_ meth_name);\n"
+        "    SV *return_sv = SI_do_callback_sv(aTHX_ cv, meth_name);\n"
         "    cfish_Obj *retval\n"
         "        = XSBind_perl_to_cfish_nullable(aTHX_ return_sv, CFISH_OBJ);\n"
         "    FREETMPS;\n"
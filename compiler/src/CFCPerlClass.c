@@ -225,6 +225,24 @@ CFCPerlClass_exclude_method(CFCPerlClass *self, const char *meth_name) {
     CFCMethod_exclude_from_host(method);
 }
 
+void
+CFCPerlClass_fast_callback(CFCPerlClass *self, const char *meth_name) {
+    if (!self->client) {
+        CFCUtil_die("Can't fast_callback %s -- can't find client for %s",
+                    meth_name, self->class_name);
+    }
+    CFCMethod *method = CFCClass_method(self->client, meth_name);
+    if (!method) {
+        CFCUtil_die("Can't fast_callback %s -- method not found in %s",
+                    meth_name, self->class_name);
+    }
+    if (!CFCMethod_novel(method)) {
+        CFCUtil_die("Can't fast_callback %s -- method not novel in %s",
+                    meth_name, self->class_name);
+    }
+    CFCMethod_set_fast_callback(method);
+}
+
 void
 CFCPerlClass_bind_constructor(CFCPerlClass *self, const char *alias,
                               const char *initializer) {
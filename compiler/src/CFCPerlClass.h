@@ -99,6 +99,13 @@ CFCPerlClass_exclude_method(CFCPerlClass *self, const char *method);
 void
 CFCPerlClass_exclude_constructor(CFCPerlClass *self);
 
+/** Generate a fast callback for a novel method.  The Perl override is looked
+ * up once per class and cached, so redefining it later has no effect.  The
+ * arguments are passed positionally rather than as label/value pairs.
+ */
+void
+CFCPerlClass_fast_callback(CFCPerlClass *self, const char *method);
+
 /** Return an array of Clownfish::CFC::Binding::Perl::Method objects
  * representing all bound methods.
  */
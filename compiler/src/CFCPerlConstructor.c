@@ -100,6 +100,7 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
     const char    *items_check   = NULL;
 
     char *param_specs = NULL;
+    char *label_index = NULL;
     char *arg_decls   = CFCPerlSub_arg_declarations((CFCPerlSub*)self, 0);
     char *locs_decl   = NULL;
     char *locate_args = NULL;
@@ -111,6 +112,7 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
         // No params.
         items_check = "items != 1";
         param_specs = CFCUtil_strdup("");
+        label_index = CFCUtil_strdup("");
         locs_decl   = CFCUtil_strdup("");
         locate_args = CFCUtil_strdup("");
     }
@@ -118,14 +120,17 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
         int num_params = num_vars - 1;
         items_check = "items < 1";
         param_specs = CFCPerlSub_build_param_specs((CFCPerlSub*)self, 1);
+        label_index = CFCPerlSub_build_label_index((CFCPerlSub*)self, 1);
         locs_decl   = CFCUtil_sprintf("    int32_t locations[%d];\n"
                                       "    SV *sv;\n",
                                       num_params);
 
         const char *pattern =
-            "    XSBind_locate_args(aTHX_ &ST(0), 1, items, param_specs,\n"
-            "                       locations, %d);\n";
-        locate_args = CFCUtil_sprintf(pattern, num_params);
+            "    XSBind_locate_indexed_args(aTHX_ &ST(0), 1, items,"
+            " param_specs,\n"
+            "                               %s_label_index, locations,"
+            " %d);\n";
+        locate_args = CFCUtil_sprintf(pattern, c_name, num_params);
     }
 
     // Compensate for swallowed refcounts.
@@ -142,6 +147,7 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
     }
 
     const char pattern[] =
+        "%s" // label_index
         "XS_INTERNAL(%s);\n"
         "XS_INTERNAL(%s) {\n"
         "    dXSARGS;\n"
@@ -167,10 +173,10 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
         "    XSRETURN(1);\n"
         "}\n\n";
     char *xsub_def
-        = CFCUtil_sprintf(pattern, c_name, c_name, param_specs, locs_decl,
-                          arg_decls, self_type_str, items_check, locate_args,
-                          arg_assigns, self_name, self_type_str, refcount_mods,
-                          func_sym, name_list);
+        = CFCUtil_sprintf(pattern, label_index, c_name, c_name, param_specs,
+                          locs_decl, arg_decls, self_type_str, items_check,
+                          locate_args, arg_assigns, self_name, self_type_str,
+                          refcount_mods, func_sym, name_list);
 
     FREEMEM(refcount_mods);
     FREEMEM(name_list);
@@ -179,6 +185,7 @@ CFCPerlConstructor_xsub_def(CFCPerlConstructor *self, CFCClass *klass) {
     FREEMEM(locate_args);
     FREEMEM(locs_decl);
     FREEMEM(arg_decls);
+    FREEMEM(label_index);
     FREEMEM(param_specs);
 
     return xsub_def;
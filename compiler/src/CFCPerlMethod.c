@@ -56,7 +56,7 @@ S_xsub_def_positional_args(CFCPerlMethod *self, CFCClass *klass);
  * onto the Perl stack.
  */
 static char*
-S_callback_start(CFCMethod *method);
+S_callback_start(CFCMethod *method, CFCClass *klass);
 
 /* Adapt the refcounts of parameters and return types.
  */
@@ -239,6 +239,7 @@ S_xsub_def_labeled_params(CFCPerlMethod *self, CFCClass *klass) {
     int num_vars = CFCParamList_num_vars(param_list);
     const char  *self_name   = CFCVariable_get_name(self_var);
     char *param_specs = CFCPerlSub_build_param_specs((CFCPerlSub*)self, 1);
+    char *label_index = CFCPerlSub_build_label_index((CFCPerlSub*)self, 1);
     char *arg_decls   = CFCPerlSub_arg_declarations((CFCPerlSub*)self, 0);
     char *meth_type_c = CFCMethod_full_typedef(method, klass);
     char *self_assign = S_self_assign_statement(self, klass);
@@ -260,6 +261,7 @@ S_xsub_def_labeled_params(CFCPerlMethod *self, CFCClass *klass) {
     }
 
     char pattern[] =
+        "%s"        // label_index
         "XS_INTERNAL(%s);\n"
         "XS_INTERNAL(%s) {\n"
         "    dXSARGS;\n"
@@ -277,8 +279,8 @@ S_xsub_def_labeled_params(CFCPerlMethod *self, CFCClass *klass) {
         "    SP -= items;\n"
         "\n"
         "    /* Locate args on Perl stack. */\n"
-        "    XSBind_locate_args(aTHX_ &ST(0), 1, items, param_specs,\n"
-        "                       locations, %d);\n"
+        "    XSBind_locate_indexed_args(aTHX_ &ST(0), 1, items, param_specs,\n"
+        "                               %s_label_index, locations, %d);\n"
         "    %s\n"  // self_assign
         "%s"        // arg_assigns
         "\n"
@@ -286,12 +288,13 @@ S_xsub_def_labeled_params(CFCPerlMethod *self, CFCClass *klass) {
         "    %s\n"  // body
         "}\n";
     char *xsub_def
-        = CFCUtil_sprintf(pattern, c_name, c_name, param_specs, num_vars - 1,
-                          locations_sv, arg_decls, meth_type_c, retval_decl,
-                          self_name, num_vars - 1, self_assign, arg_assigns,
-                          body);
+        = CFCUtil_sprintf(pattern, label_index, c_name, c_name, param_specs,
+                          num_vars - 1, locations_sv, arg_decls, meth_type_c,
+                          retval_decl, self_name, c_name, num_vars - 1,
+                          self_assign, arg_assigns, body);
 
     FREEMEM(param_specs);
+    FREEMEM(label_index);
     FREEMEM(arg_decls);
     FREEMEM(meth_type_c);
     FREEMEM(self_assign);
@@ -407,7 +410,7 @@ CFCPerlMethod_callback_def(CFCMethod *method, CFCClass *klass) {
         callback_body = S_invalid_callback_body(method);
     }
     else {
-        char *start = S_callback_start(method);
+        char *start = S_callback_start(method, klass);
         char *refcount_mods = S_callback_refcount_mods(method);
 
         if (CFCType_is_void(return_type)) {
@@ -453,21 +456,47 @@ CFCPerlMethod_callback_def(CFCMethod *method, CFCClass *klass) {
 }
 
 static char*
-S_callback_start(CFCMethod *method) {
+S_callback_start(CFCMethod *method, CFCClass *klass) {
     CFCParamList *param_list = CFCMethod_get_param_list(method);
-    static const char pattern[] =
-        "    dTHX;\n"
-        "    dSP;\n"
-        "    EXTEND(SP, %d);\n"
-        "    ENTER;\n"
-        "    SAVETMPS;\n"
-        "    PUSHMARK(SP);\n"
-        "    mPUSHs((SV*)CFISH_Obj_To_Host((cfish_Obj*)self, NULL));\n";
     int num_args = CFCParamList_num_vars(param_list) - 1;
-    int num_to_extend = num_args == 0 ? 1
-                      : num_args == 1 ? 2
-                      : 1 + (num_args * 2);
-    char *params = CFCUtil_sprintf(pattern, num_to_extend);
+    int fast = CFCMethod_fast_callback(method);
+    char *params = NULL;
+
+    if (fast) {
+        // Look up the cached CV of the override and pass args positionally.
+        static const char pattern[] =
+            "    dTHX;\n"
+            "    dSP;\n"
+            "    EXTEND(SP, %d);\n"
+            "    ENTER;\n"
+            "    SAVETMPS;\n"
+            "    SV *self_sv = sv_2mortal((SV*)CFISH_Obj_To_Host("
+            "(cfish_Obj*)self, NULL));\n"
+            "    CV *cv = XSBind_callback_cv(aTHX_ (cfish_Obj*)self, self_sv,\n"
+            "                                %s, \"%s\");\n"
+            "    PUSHMARK(SP);\n"
+            "    PUSHs(self_sv);\n";
+        char *offset_sym = CFCMethod_full_offset_sym(method, klass);
+        char *perl_name  = CFCPerlMethod_perl_name(method);
+        params = CFCUtil_sprintf(pattern, 1 + num_args, offset_sym,
+                                 perl_name);
+        FREEMEM(perl_name);
+        FREEMEM(offset_sym);
+    }
+    else {
+        static const char pattern[] =
+            "    dTHX;\n"
+            "    dSP;\n"
+            "    EXTEND(SP, %d);\n"
+            "    ENTER;\n"
+            "    SAVETMPS;\n"
+            "    PUSHMARK(SP);\n"
+            "    mPUSHs((SV*)CFISH_Obj_To_Host((cfish_Obj*)self, NULL));\n";
+        int num_to_extend = num_args == 0 ? 1
+                          : num_args == 1 ? 2
+                          : 1 + (num_args * 2);
+        params = CFCUtil_sprintf(pattern, num_to_extend);
+    }
 
     // Iterate over arguments, mapping them to Perl scalars.
     CFCVariable **arg_vars = CFCParamList_get_variables(param_list);
@@ -479,7 +508,7 @@ S_callback_start(CFCMethod *method) {
         const char  *c_type    = CFCType_to_c(type);
 
         // Add labels when there are two or more parameters.
-        if (num_args > 1) {
+        if (num_args > 1 && !fast) {
             char num_buf[20];
             sprintf(num_buf, "%d", (int)strlen(name));
             params = CFCUtil_cat(params, "    mPUSHp(\"", name, "\", ",
@@ -606,12 +635,14 @@ static char*
 S_void_callback_body(CFCMethod *method, const char *callback_start,
                      const char *refcount_mods) {
     char *perl_name = CFCPerlMethod_perl_name(method);
+    const char *cv  = CFCMethod_fast_callback(method) ? "cv" : "NULL";
     const char pattern[] =
         "%s"
-        "    S_finish_callback_void(aTHX_ \"%s\");\n"
+        "    S_finish_callback_void(aTHX_ %s, \"%s\");\n"
         "%s";
     char *callback_body
-        = CFCUtil_sprintf(pattern, callback_start, perl_name, refcount_mods);
+        = CFCUtil_sprintf(pattern, callback_start, cv, perl_name,
+                          refcount_mods);
 
     FREEMEM(perl_name);
     return callback_body;
@@ -640,15 +671,16 @@ S_primitive_callback_body(CFCMethod *method, const char *callback_start,
     }
 
     char *perl_name = CFCPerlMethod_perl_name(method);
+    const char *cv  = CFCMethod_fast_callback(method) ? "cv" : "NULL";
 
     char pattern[] =
         "%s"
-        "    %s retval = (%s)%s(aTHX_ \"%s\");\n"
+        "    %s retval = (%s)%s(aTHX_ %s, \"%s\");\n"
         "%s"
         "    return retval;\n";
     char *callback_body
         = CFCUtil_sprintf(pattern, callback_start, ret_type_str, ret_type_str,
-                          callback_func, perl_name, refcount_mods);
+                          callback_func, cv, perl_name, refcount_mods);
 
     FREEMEM(perl_name);
     return callback_body;
@@ -662,15 +694,16 @@ S_obj_callback_body(CFCMethod *method, const char *callback_start,
     const char *nullable  = CFCType_nullable(return_type) ? "true" : "false";
 
     char *perl_name = CFCPerlMethod_perl_name(method);
+    const char *cv  = CFCMethod_fast_callback(method) ? "cv" : "NULL";
 
     char pattern[] =
         "%s"
-        "    %s retval = (%s)S_finish_callback_obj(aTHX_ self, \"%s\", %s);\n"
+        "    %s retval = (%s)S_finish_callback_obj(aTHX_ self, %s, \"%s\", %s);\n"
         "%s"
         "    return retval;\n";
     char *callback_body
         = CFCUtil_sprintf(pattern, callback_start, ret_type_str, ret_type_str,
-                          perl_name, nullable, refcount_mods);
+                          cv, perl_name, nullable, refcount_mods);
 
     FREEMEM(perl_name);
     return callback_body;
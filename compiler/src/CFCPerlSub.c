@@ -149,6 +149,62 @@ CFCPerlSub_build_param_specs(CFCPerlSub *self, int first) {
     return param_specs;
 }
 
+char*
+CFCPerlSub_build_label_index(CFCPerlSub *self, int first) {
+    CFCParamList  *param_list = self->param_list;
+    CFCVariable  **arg_vars   = CFCParamList_get_variables(param_list);
+    int            num_vars   = CFCParamList_num_vars(param_list);
+
+    char *cases = CFCUtil_strdup("");
+
+    // Switch on the label length, then compare against the labels of that
+    // length in declaration order.
+    for (int i = first; i < num_vars; i++) {
+        const char *name = CFCVariable_get_name(arg_vars[i]);
+        size_t      len  = strlen(name);
+
+        int seen = false;
+        for (int j = first; j < i; j++) {
+            if (strlen(CFCVariable_get_name(arg_vars[j])) == len) {
+                seen = true;
+                break;
+            }
+        }
+        if (seen) { continue; }
+
+        char *case_start = CFCUtil_sprintf("        case %d:\n", (int)len);
+        cases = CFCUtil_cat(cases, case_start, NULL);
+        FREEMEM(case_start);
+
+        for (int j = i; j < num_vars; j++) {
+            const char *other = CFCVariable_get_name(arg_vars[j]);
+            if (strlen(other) != len) { continue; }
+            char *test = CFCUtil_sprintf(
+                "            if (memcmp(label, \"%s\", %d) == 0) {"
+                " return %d; }\n",
+                other, (int)len, j - first);
+            cases = CFCUtil_cat(cases, test, NULL);
+            FREEMEM(test);
+        }
+
+        cases = CFCUtil_cat(cases, "            break;\n", NULL);
+    }
+
+    const char pattern[] =
+        "static int32_t\n"
+        "%s_label_index(const char *label, STRLEN label_len) {\n"
+        "    switch (label_len) {\n"
+        "%s"
+        "    }\n"
+        "    return -1;\n"
+        "}\n"
+        "\n";
+    char *label_index = CFCUtil_sprintf(pattern, self->c_name, cases);
+
+    FREEMEM(cases);
+    return label_index;
+}
+
 char*
 CFCPerlSub_arg_assignments(CFCPerlSub *self) {
     CFCParamList  *param_list = self->param_list;
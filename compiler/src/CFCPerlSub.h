@@ -83,6 +83,14 @@ CFCPerlSub_arg_name_list(CFCPerlSub *self);
 char*
 CFCPerlSub_build_param_specs(CFCPerlSub *self, int first);
 
+/** Generate a static function which maps a param label to its index in the
+ * param specs, switching on the length of the label.  The function is named
+ * after the XSUB with the suffix "_label_index".  Parameters from `first`
+ * onwards are included.
+ */
+char*
+CFCPerlSub_build_label_index(CFCPerlSub *self, int first);
+
 /** Generate code that that converts and assigns the arguments.
  */
 char*
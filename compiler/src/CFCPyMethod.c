@@ -136,8 +136,11 @@ S_gen_declaration(CFCVariable *var, const char *val) {
     return result;
 }
 
+/* Return the name of the CFBind conversion routine for a param and store the
+ * argument for the routine in `target_ptr`.
+ */
 static char*
-S_gen_target(CFCVariable *var, const char *value) {
+S_gen_converter(CFCVariable *var, const char *value, char **target_ptr) {
     CFCType *type = CFCVariable_get_type(var);
     const char *specifier = CFCType_get_specifier(type);
     const char *micro_sym = CFCVariable_get_name(var);
@@ -177,17 +180,19 @@ S_gen_target(CFCVariable *var, const char *value) {
     else {
         dest_name = "INVALID";
     }
-    char *content = CFCUtil_sprintf(", CFBind_%sconvert_%s, &%s",
-                                    maybe_maybe, dest_name, var_name);
+    *target_ptr = CFCUtil_sprintf("&%s", var_name);
     FREEMEM(var_name);
-    return content;
+    return CFCUtil_sprintf("CFBind_%sconvert_%s", maybe_maybe, dest_name);
 }
 
 /* Generate the code which parses arguments passed from Python and converts
- * them to Clownfish-flavored C values.
+ * them to Clownfish-flavored C values.  If `fastcall` is true, the code for
+ * the vectorcall protocol is generated as well, conditional on
+ * CFBIND_HAS_FASTCALL.
  */
 static char*
-S_gen_arg_parsing(CFCParamList *param_list, int first_tick, char **error) {
+S_gen_arg_parsing(CFCParamList *param_list, int first_tick, int fastcall,
+                  char **error) {
     char *content = NULL;
 
     CFCVariable **vars = CFCParamList_get_variables(param_list);
@@ -198,6 +203,9 @@ S_gen_arg_parsing(CFCParamList *param_list, int first_tick, char **error) {
     char *keywords     = CFCUtil_strdup("");
     char *format_str   = CFCUtil_strdup("");
     char *targets      = CFCUtil_strdup("");
+    char *fast_convs   = CFCUtil_strdup("");
+    char *fast_targets = CFCUtil_strdup("");
+    int num_required = 0;
     int optional_started = 0;
 
     for (int i = first_tick; i < num_vars; i++) {
@@ -213,6 +221,7 @@ S_gen_arg_parsing(CFCParamList *param_list, int first_tick, char **error) {
                 *error = "Required after optional param";
                 goto CLEAN_UP_AND_RETURN;
             }
+            num_required++;
         }
         else {
             if (!optional_started) {
@@ -226,27 +235,64 @@ S_gen_arg_parsing(CFCParamList *param_list, int first_tick, char **error) {
         declarations = CFCUtil_cat(declarations, declaration, NULL);
         FREEMEM(declaration);
 
-        char *target = S_gen_target(var, val);
-        targets = CFCUtil_cat(targets, target, NULL);
+        char *target = NULL;
+        char *converter = S_gen_converter(var, val, &target);
+        const char *sep = i == first_tick ? "" : ",";
+        targets = CFCUtil_cat(targets, ", ", converter, ", ", target, NULL);
+        fast_convs = CFCUtil_cat(fast_convs, sep, "\n        (CFBindConverter)",
+                                 converter, NULL);
+        fast_targets = CFCUtil_cat(fast_targets, sep, "\n        ", target,
+                                   NULL);
+        FREEMEM(converter);
         FREEMEM(target);
     }
 
     char parse_pattern[] =
-        "%s"
         "    char *keywords[] = {%sNULL};\n"
         "    char *fmt = \"%s\";\n"
         "    int ok = PyArg_ParseTupleAndKeywords(args, kwargs, fmt,\n"
         "        keywords%s);\n"
         "    if (!ok) { return NULL; }\n"
         ;
-    content = CFCUtil_sprintf(parse_pattern, declarations, keywords,
-                              format_str, targets);
+    char *parsing = CFCUtil_sprintf(parse_pattern, keywords, format_str,
+                                    targets);
+
+    if (!fastcall) {
+        content = CFCUtil_sprintf("%s%s", declarations, parsing);
+    }
+    else {
+        int num_params = num_vars - first_tick;
+        char fast_pattern[] =
+            "%s"
+            "#ifdef CFBIND_HAS_FASTCALL\n"
+            "    static const char *keywords[] = {%sNULL};\n"
+            "    static PyObject *py_keywords[%d];\n"
+            "    CFBindConverter converters[%d] = {%s\n"
+            "    };\n"
+            "    void *targets[%d] = {%s\n"
+            "    };\n"
+            "    PyObject *values[%d];\n"
+            "    int ok = CFBind_parse_fastcall(args, nargs, kwnames, keywords,\n"
+            "        py_keywords, %d, %d, converters, targets, values);\n"
+            "    if (!ok) { return NULL; }\n"
+            "#else\n"
+            "%s"
+            "#endif\n"
+            ;
+        content = CFCUtil_sprintf(fast_pattern, declarations, keywords,
+                                  num_params, num_params, fast_convs,
+                                  num_params, fast_targets, num_params,
+                                  num_params, num_required, parsing);
+    }
+    FREEMEM(parsing);
 
 CLEAN_UP_AND_RETURN:
     FREEMEM(declarations);
     FREEMEM(keywords);
     FREEMEM(format_str);
     FREEMEM(targets);
+    FREEMEM(fast_convs);
+    FREEMEM(fast_targets);
     return content;
 }
 
@@ -400,19 +446,19 @@ S_maybe_unreachable(CFCType *return_type) {
 }
 
 static char*
-S_meth_top(CFCMethod *method) {
+S_meth_top(CFCMethod *method, const char *meth_sym) {
     CFCParamList *param_list = CFCMethod_get_param_list(method);
 
     if (CFCParamList_num_vars(param_list) == 1) {
         char pattern[] =
-            "(PyObject *self, PyObject *unused) {\n"
+            "S_%s(PyObject *self, PyObject *unused) {\n"
             "    CFISH_UNUSED_VAR(unused);\n"
             ;
-        return CFCUtil_sprintf(pattern);
+        return CFCUtil_sprintf(pattern, meth_sym);
     }
     else {
         char *error = NULL;
-        char *arg_parsing = S_gen_arg_parsing(param_list, 1, &error);
+        char *arg_parsing = S_gen_arg_parsing(param_list, 1, true, &error);
         if (error) {
             CFCUtil_die("%s in %s", error, CFCMethod_get_name(method));
         }
@@ -421,11 +467,18 @@ S_meth_top(CFCMethod *method) {
         }
         char *decs = S_gen_decs(param_list, 1);
         char pattern[] =
-            "(PyObject *self, PyObject *args, PyObject *kwargs) {\n"
+            "#ifdef CFBIND_HAS_FASTCALL\n"
+            "S_%s(PyObject *self, PyObject *const *args, Py_ssize_t nargs,\n"
+            "    PyObject *kwnames) {\n"
+            "#else\n"
+            "S_%s(PyObject *self, PyObject *args, PyObject *kwargs) {\n"
+            "#endif\n"
             "%s" // decs
             "%s"
             ;
-        char *result = CFCUtil_sprintf(pattern, decs, arg_parsing);
+        char *result = CFCUtil_sprintf(pattern, meth_sym, meth_sym, decs,
+                                       arg_parsing);
+        FREEMEM(decs);
         FREEMEM(arg_parsing);
         return result;
     }
@@ -543,7 +596,7 @@ CFCPyMethod_wrapper(CFCMethod *method, CFCClass *invoker) {
     CFCParamList *param_list  = CFCMethod_get_param_list(method);
     CFCType      *return_type = CFCMethod_get_return_type(method);
     char *meth_sym   = CFCMethod_full_method_sym(method, invoker);
-    char *meth_top   = S_meth_top(method);
+    char *meth_top   = S_meth_top(method, meth_sym);
     char *increfs    = S_gen_arg_increfs(param_list, 1);
     char *decrefs    = S_gen_decrefs(param_list, 1);
     char *invocation = S_gen_meth_invocation(method, invoker);
@@ -562,7 +615,7 @@ CFCPyMethod_wrapper(CFCMethod *method, CFCClass *invoker) {
 
     char pattern[] =
         "static PyObject*\n"
-        "S_%s%s"
+        "%s"
         "%s" // increfs
         "%s" // invocation
         "%s" // decrefs
@@ -572,8 +625,8 @@ CFCPyMethod_wrapper(CFCMethod *method, CFCClass *invoker) {
         "%s" // ret
         "}\n"
         ;
-    char *wrapper = CFCUtil_sprintf(pattern, meth_sym, meth_top,
-                                    increfs, invocation, decrefs, ret);
+    char *wrapper = CFCUtil_sprintf(pattern, meth_top, increfs, invocation,
+                                    decrefs, ret);
     FREEMEM(ret);
     FREEMEM(invocation);
     FREEMEM(decrefs);
@@ -596,7 +649,7 @@ CFCPyMethod_constructor_wrapper(CFCFunction *init_func, CFCClass *invoker) {
     const char *class_var  = CFCClass_full_class_var(invoker);
     const char *struct_sym = CFCClass_full_struct_sym(invoker);
     char *error = NULL;
-    char *arg_parsing = S_gen_arg_parsing(param_list, 1, &error);
+    char *arg_parsing = S_gen_arg_parsing(param_list, 1, false, &error);
     if (error) {
         CFCUtil_die("%s in constructor for %s", error,
                     CFCClass_get_name(invoker));
@@ -643,7 +696,7 @@ CFCPyMethod_pymethoddef(CFCMethod *method, CFCClass *invoker) {
     CFCParamList *param_list = CFCMethod_get_param_list(method);
     const char *flags = CFCParamList_num_vars(param_list) == 1
                         ? "METH_NOARGS"
-                        : "METH_KEYWORDS|METH_VARARGS";
+                        : "CFBIND_METH_KEYWORDS";
     char *meth_sym = CFCMethod_full_method_sym(method, invoker);
     char *micro_sym = CFCUtil_strdup(CFCSymbol_get_name((CFCSymbol*)method));
     for (int i = 0; micro_sym[i] != 0; i++) {
@@ -388,22 +388,29 @@ S_gen_type_linkups(CFCPython *self, CFCParcel *parcel, CFCClass **ordered) {
         num_items++;
     }
 
+    if (num_items == 0) {
+        FREEMEM(handles);
+        FREEMEM(py_types);
+        return CFCUtil_strdup("static void\n"
+                              "S_link_py_types(void) {\n"
+                              "}\n");
+    }
+
+    // The arrays are kept by CFBind_assoc_py_types, so they must be static.
+    // They're filled at runtime because the addresses of class vars
+    // imported from a shared library aren't always constant expressions.
     char pattern[] =
         "static void\n"
         "S_link_py_types(void) {\n"
-        "    const int num_items = %d;\n"
-        "    size_t handles_size  = num_items * sizeof(cfish_Class**);\n"
-        "    size_t py_types_size = num_items * sizeof(PyTypeObject*);\n"
-        "    cfish_Class ***handles  = (cfish_Class***)CFISH_MALLOCATE(handles_size);\n"
-        "    PyTypeObject **py_types = (PyTypeObject**)CFISH_MALLOCATE(py_types_size);\n"
+        "    static cfish_Class **handles[%d];\n"
+        "    static PyTypeObject *py_types[%d];\n"
         "%s\n"
         "%s\n"
-        "    CFBind_assoc_py_types(handles, py_types, num_items);\n"
-        "    CFISH_FREEMEM(handles);\n"
-        "    CFISH_FREEMEM(py_types);\n"
+        "    CFBind_assoc_py_types(handles, py_types, %d);\n"
         "}\n"
         ;
-    char *content = CFCUtil_sprintf(pattern, num_items, handles, py_types);
+    char *content = CFCUtil_sprintf(pattern, num_items, num_items, handles,
+                                    py_types, num_items);
 
     FREEMEM(handles);
     FREEMEM(py_types);
@@ -183,6 +183,7 @@ extern const CFCTestBatch CFCTEST_BATCH_METHOD;
 extern const CFCTestBatch CFCTEST_BATCH_PARAM_LIST;
 extern const CFCTestBatch CFCTEST_BATCH_PARCEL;
 extern const CFCTestBatch CFCTEST_BATCH_PARSER;
+extern const CFCTestBatch CFCTEST_BATCH_PERL_SUB;
 extern const CFCTestBatch CFCTEST_BATCH_SYMBOL;
 extern const CFCTestBatch CFCTEST_BATCH_TYPE;
 extern const CFCTestBatch CFCTEST_BATCH_UTIL;
@@ -18,6 +18,7 @@
 
 #define CFC_USE_TEST_MACROS
 #include "CFCBase.h"
+#include "CFCBindMethod.h"
 #include "CFCClass.h"
 #include "CFCFileSpec.h"
 #include "CFCFunction.h"
@@ -44,7 +45,7 @@ S_has_symbol(CFCSymbol **symbols, const char *name);
 
 const CFCTestBatch CFCTEST_BATCH_CLASS = {
     "Clownfish::CFC::Model::Class",
-    93,
+    98,
     S_run_tests
 };
 
@@ -211,6 +212,14 @@ S_run_tests(CFCTest *test) {
     CFCClass_add_child(foo, foo_jr);
     CFCClass_add_child(foo_jr, final_foo);
 
+    CFCParcel *remote = CFCParcel_new("Remote", NULL, NULL, NULL, NULL);
+    CFCParcel_register(remote);
+    CFCClass *remote_foo
+        = CFCClass_create(remote, NULL, "Remote::RemoteFoo", NULL, NULL,
+                          NULL, "Foo", false, false, false);
+    CFCClass_resolve_types(remote_foo);
+    CFCClass_add_child(foo, remote_foo);
+
     {
         CFCClass *bar
             = CFCClass_create(neato, NULL, "Foo::FooJr::FinalFoo::Bar", NULL,
@@ -266,6 +275,28 @@ S_run_tests(CFCTest *test) {
        "Finalize inherited method");
     OK(test, !CFCMethod_final(CFCClass_method(foo_jr, "Do_Stuff")),
        "Don't finalize method in parent");
+    OK(test, CFCClass_fixed_vtable(foo), "fixed_vtable, root class");
+    OK(test, CFCClass_fixed_vtable(final_foo),
+       "fixed_vtable, ancestors in same parcel");
+    OK(test, !CFCClass_fixed_vtable(remote_foo),
+       "no fixed_vtable, parent in other parcel");
+
+    {
+        CFCMethod *do_stuff_remote = CFCClass_method(remote_foo, "Do_Stuff");
+        char *offset_const;
+
+        offset_const = CFCBindMeth_offset_const(do_stuff_remote, remote_foo);
+        OK(test, offset_const == NULL,
+           "no offset constant, parent in other parcel");
+        FREEMEM(offset_const);
+
+        CFCParcel_set_const_offsets(remote, true);
+        offset_const = CFCBindMeth_offset_const(do_stuff_remote, remote_foo);
+        OK(test, offset_const != NULL
+                 && strstr(offset_const, "CFISH_VTABLE_OFFSET + 0 *") != NULL,
+           "offset constant with const_offsets");
+        FREEMEM(offset_const);
+    }
 
     {
         CFCVariable **inert_vars = CFCClass_inert_vars(foo);
@@ -445,6 +476,8 @@ S_run_tests(CFCTest *test) {
     CFCBase_decref((CFCBase*)foo);
     CFCBase_decref((CFCBase*)foo_jr);
     CFCBase_decref((CFCBase*)final_foo);
+    CFCBase_decref((CFCBase*)remote_foo);
+    CFCBase_decref((CFCBase*)remote);
     CFCBase_decref((CFCBase*)inert_foo);
     CFCBase_decref((CFCBase*)do_stuff);
 
@@ -18,6 +18,7 @@
 
 #define CFC_USE_TEST_MACROS
 #include "CFCBase.h"
+#include "CFCBindMethod.h"
 #include "CFCClass.h"
 #include "CFCMethod.h"
 #include "CFCParamList.h"
@@ -48,9 +49,12 @@ S_run_overridden_tests(CFCTest *test);
 static void
 S_run_final_tests(CFCTest *test);
 
+static void
+S_run_monomorphic_tests(CFCTest *test);
+
 const CFCTestBatch CFCTEST_BATCH_METHOD = {
     "Clownfish::CFC::Model::Method",
-    76,
+    92,
     S_run_tests
 };
 
@@ -60,6 +64,7 @@ S_run_tests(CFCTest *test) {
     S_run_parser_tests(test);
     S_run_overridden_tests(test);
     S_run_final_tests(test);
+    S_run_monomorphic_tests(test);
 }
 
 static char*
@@ -196,6 +201,16 @@ S_run_basic_tests(CFCTest *test) {
         CFCBase_decref((CFCBase*)excluded);
     }
 
+    {
+        CFCMethod *fast
+            = CFCMethod_new(NULL, "Fast", return_type, param_list, NULL,
+                            neato_foo, 0, 0);
+        OK(test, !CFCMethod_fast_callback(fast), "no fast callback by default");
+        CFCMethod_set_fast_callback(fast);
+        OK(test, CFCMethod_fast_callback(fast), "set fast callback");
+        CFCBase_decref((CFCBase*)fast);
+    }
+
     CFCBase_decref((CFCBase*)parser);
     CFCBase_decref((CFCBase*)neato_parcel);
     CFCBase_decref((CFCBase*)neato_foo);
@@ -336,3 +351,73 @@ S_run_final_tests(CFCTest *test) {
     CFCParcel_reap_singletons();
 }
 
+static void
+S_run_monomorphic_tests(CFCTest *test) {
+    CFCParser *parser = CFCParser_new();
+    CFCParcel *neato_parcel
+        = CFCTest_parse_parcel(test, parser, "parcel Neato;");
+    const char *class_src =
+        "class Neato::Foo {\n"
+        "    monomorphic int32_t Get_Num(Foo *self);\n"
+        "    monomorphic void Set_Num(Foo *self, int32_t num);\n"
+        "    int32_t Get_Other(Foo *self);\n"
+        "}\n";
+    CFCClass *foo = CFCTest_parse_class(test, parser, class_src);
+    CFCClass_resolve_types(foo);
+    CFCClass_grow_tree(foo);
+
+    CFCMethod *get_num   = CFCClass_method(foo, "Get_Num");
+    CFCMethod *set_num   = CFCClass_method(foo, "Set_Num");
+    CFCMethod *get_other = CFCClass_method(foo, "Get_Other");
+    OK(test, CFCMethod_monomorphic(get_num), "monomorphic");
+    OK(test, !CFCMethod_monomorphic(get_other), "not monomorphic by default");
+
+    {
+        CFCMethod *final = CFCMethod_finalize(get_num);
+        OK(test, CFCMethod_monomorphic(final), "finalize keeps monomorphic");
+        CFCBase_decref((CFCBase*)final);
+    }
+
+    {
+        char *def = CFCBindMeth_method_def(get_num, foo);
+        OK(test, strstr(def, "#if defined(CFP_NEATO)") != NULL,
+           "guard enabled within parcel");
+        OK(test, strstr(def, "cfish_obj_has_class(self, NEATO_FOO)") != NULL,
+           "guard checks class");
+        OK(test, strstr(def, "return NEATO_Foo_Get_Num_IMP(self);") != NULL,
+           "guard calls IMP directly");
+        OK(test, strstr(def, "cfish_obj_method(self,") != NULL,
+           "fall back to vtable");
+        FREEMEM(def);
+    }
+
+    {
+        char *def = CFCBindMeth_method_def(set_num, foo);
+        OK(test,
+           strstr(def, "NEATO_Foo_Set_Num_IMP(self, num);\n"
+                       "        return;\n") != NULL,
+           "guard in void method");
+        FREEMEM(def);
+    }
+
+    {
+        char *def = CFCBindMeth_method_def(get_other, foo);
+        OK(test, strstr(def, "cfish_obj_has_class") == NULL,
+           "no guard in other methods");
+        FREEMEM(def);
+    }
+
+    {
+        char *dec = CFCBindMeth_imp_declaration(get_num, foo);
+        OK(test, strstr(dec, "NEATO_VISIBLE") != NULL,
+           "IMP of monomorphic method is exported");
+        FREEMEM(dec);
+    }
+
+    CFCBase_decref((CFCBase*)parser);
+    CFCBase_decref((CFCBase*)neato_parcel);
+    CFCBase_decref((CFCBase*)foo);
+
+    CFCParcel_reap_singletons();
+}
+
@@ -0,0 +1,161 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#define CFC_USE_TEST_MACROS
+#include "CFCBase.h"
+#include "CFCClass.h"
+#include "CFCMethod.h"
+#include "CFCParamList.h"
+#include "CFCParcel.h"
+#include "CFCParser.h"
+#include "CFCPerlMethod.h"
+#include "CFCPerlSub.h"
+#include "CFCTest.h"
+#include "CFCType.h"
+#include "CFCUtil.h"
+
+#ifndef true
+  #define true 1
+  #define false 0
+#endif
+
+static void
+S_run_tests(CFCTest *test);
+
+const CFCTestBatch CFCTEST_BATCH_PERL_SUB = {
+    "Clownfish::CFC::Binding::Perl::Subroutine",
+    23,
+    S_run_tests
+};
+
+static CFCPerlSub*
+S_new_perl_method(CFCTest *test, CFCParser *parser, CFCClass *klass,
+                  const char *name, const char *param_list_src) {
+    CFCType *return_type = CFCTest_parse_type(test, parser, "void");
+    CFCParamList *param_list
+        = CFCTest_parse_param_list(test, parser, param_list_src);
+    CFCMethod *method
+        = CFCMethod_new(NULL, name, return_type, param_list, NULL, klass, 0,
+                        0);
+    CFCPerlMethod *perl_method = CFCPerlMethod_new(klass, method);
+
+    CFCBase_decref((CFCBase*)return_type);
+    CFCBase_decref((CFCBase*)param_list);
+    CFCBase_decref((CFCBase*)method);
+
+    return (CFCPerlSub*)perl_method;
+}
+
+static void
+S_run_tests(CFCTest *test) {
+    CFCParser *parser = CFCParser_new();
+    CFCParcel *neato_parcel
+        = CFCTest_parse_parcel(test, parser, "parcel Neato;");
+    CFCClass *foo_class
+        = CFCClass_create(neato_parcel, NULL, "Neato::Foo", NULL, NULL, NULL,
+                          NULL, false, false, false);
+
+    {
+        CFCPerlSub *sub
+            = S_new_perl_method(test, parser, foo_class, "Frob",
+                                "(Foo *self, int32_t a, int32_t bb,"
+                                " int32_t cc = 0, int32_t dddd = 1)");
+        char *label_index = CFCPerlSub_build_label_index(sub, 1);
+        const char *expected =
+            "static int32_t\n"
+            "XS_Neato_Foo_frob_label_index(const char *label,"
+            " STRLEN label_len) {\n"
+            "    switch (label_len) {\n"
+            "        case 1:\n"
+            "            if (memcmp(label, \"a\", 1) == 0) { return 0; }\n"
+            "            break;\n"
+            "        case 2:\n"
+            "            if (memcmp(label, \"bb\", 2) == 0) { return 1; }\n"
+            "            if (memcmp(label, \"cc\", 2) == 0) { return 2; }\n"
+            "            break;\n"
+            "        case 4:\n"
+            "            if (memcmp(label, \"dddd\", 4) == 0) { return 3; }\n"
+            "            break;\n"
+            "    }\n"
+            "    return -1;\n"
+            "}\n"
+            "\n";
+        STR_EQ(test, label_index, expected, "build_label_index");
+
+        const char *case_2 = strstr(label_index, "case 2:");
+        OK(test, case_2 && !strstr(case_2 + 1, "case 2:"),
+           "labels of the same length share a case");
+        OK(test, !strstr(label_index, "\"self\""),
+           "self is skipped when first is 1");
+        FREEMEM(label_index);
+
+        label_index = CFCPerlSub_build_label_index(sub, 0);
+        OK(test, strstr(label_index, "\"self\", 4) == 0) { return 0; }")
+                 != NULL,
+           "self is included when first is 0");
+        OK(test, strstr(label_index, "\"dddd\", 4) == 0) { return 4; }")
+                 != NULL,
+           "indices are relative to first");
+        {
+            // "self" and "dddd" are both four characters long.
+            const char *case_4 = strstr(label_index, "case 4:");
+            const char *self   = strstr(label_index, "\"self\"");
+            const char *dddd   = strstr(label_index, "\"dddd\"");
+            OK(test, case_4 && self && dddd && case_4 < self && self < dddd
+                     && !strstr(case_4 + 1, "case 4:"),
+               "labels of the same length are tested in declaration order");
+        }
+        FREEMEM(label_index);
+
+        CFCBase_decref((CFCBase*)sub);
+    }
+
+    {
+        CFCPerlSub *sub
+            = S_new_perl_method(test, parser, foo_class, "Twiddle",
+                                "(Foo *self, int32_t x_len, int32_t y_len)");
+        char *label_index = CFCPerlSub_build_label_index(sub, 1);
+        OK(test, strstr(label_index, "XS_Neato_Foo_twiddle_label_index")
+                 != NULL,
+           "function named after the XSUB");
+        OK(test, strstr(label_index, "\"x_len\", 5) == 0) { return 0; }")
+                 && strstr(label_index,
+                           "\"y_len\", 5) == 0) { return 1; }"),
+           "distinct labels of the same length");
+        FREEMEM(label_index);
+        CFCBase_decref((CFCBase*)sub);
+    }
+
+    {
+        CFCPerlSub *sub
+            = S_new_perl_method(test, parser, foo_class, "Poke",
+                                "(Foo *self)");
+        char *label_index = CFCPerlSub_build_label_index(sub, 1);
+        OK(test, !strstr(label_index, "case ")
+                 && strstr(label_index, "return -1;"),
+           "no labels");
+        FREEMEM(label_index);
+        CFCBase_decref((CFCBase*)sub);
+    }
+
+    CFCBase_decref((CFCBase*)parser);
+    CFCBase_decref((CFCBase*)neato_parcel);
+    CFCBase_decref((CFCBase*)foo_class);
+
+    CFCParcel_reap_singletons();
+}
@@ -0,0 +1,42 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Measure the time it takes to bootstrap the Clownfish parcel.  A parcel
+ * can only be bootstrapped once per process, so the Makefile runs the
+ * executable several times.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "cfish_parcel.h"
+
+int
+main() {
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+
+    cfish_bootstrap_parcel();
+
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+
+    uint64_t usec = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000
+                    + (t1.tv_usec - t0.tv_usec);
+    printf("usec to bootstrap parcel Clownfish: %" PRIu64 "\n", usec);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Microbenchmarks for error trapping with Err_trap and the error return
+ * protocol of Err_attempt.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define CFISH_USE_SHORT_NAMES
+
+#include "cfish_parcel.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/String.h"
+
+#define NOINLINE __attribute__ ((noinline))
+
+typedef void (*bench_t)(uint64_t iterations);
+
+static void
+S_noop(void *context) {
+    (void)context;
+}
+
+static void
+S_throw(void *context) {
+    (void)context;
+    THROW(ERR, "error");
+}
+
+static bool
+S_succeed(void *context) {
+    (void)context;
+    return true;
+}
+
+static bool
+S_fail(void *context) {
+    (void)context;
+    Err_set_error(Err_new(Str_newf("error")));
+    return false;
+}
+
+NOINLINE void
+trap_noop(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Err_trap(S_noop, NULL);
+    }
+}
+
+NOINLINE void
+trap_throw(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        DECREF(Err_trap(S_throw, NULL));
+    }
+}
+
+NOINLINE void
+attempt_succeed(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Err_attempt(S_succeed, NULL);
+    }
+}
+
+NOINLINE void
+attempt_fail(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        DECREF(Err_attempt(S_fail, NULL));
+    }
+}
+
+NOINLINE void
+get_error(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        Err_get_error();
+    }
+}
+
+static void
+bench(bench_t fn, uint64_t iterations, const char *name) {
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+
+    fn(iterations);
+
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+
+    uint64_t usec = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000
+                    + (t1.tv_usec - t0.tv_usec);
+    printf("ns/op with %s: %f\n", name,
+           (usec * 1000.0) / (double)iterations);
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t iterations;
+    if (argc > 1) {
+        iterations = strtoll(argv[1], NULL, 10);
+    }
+    else {
+        iterations = UINT64_C(10000000);
+    }
+    cfish_bootstrap_parcel();
+
+    bench(trap_noop, iterations, "Err_trap no-op");
+    bench(trap_throw, iterations / 10, "Err_trap throwing");
+    bench(attempt_succeed, iterations, "Err_attempt succeeding");
+    bench(attempt_fail, iterations / 10, "Err_attempt failing");
+    bench(get_error, iterations, "Err_get_error");
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Microbenchmark for the per-call cost of invoking final methods from
+ * outside the Clownfish parcel.
+ *
+ * The benchmark is compiled twice: `exe` uses vtable dispatch like every
+ * other parcel by default, `exe_devirt` defines CFISH_DEVIRTUALIZE which
+ * makes the generated wrappers of final methods call the exported
+ * implementing functions directly.  Obj_Equals on a String ends up in the
+ * same function as Str_Equals, but is always dispatched through the vtable.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define CFISH_USE_SHORT_NAMES
+
+#include "cfish_parcel.h"
+#include "Clownfish/Obj.h"
+#include "Clownfish/String.h"
+#include "Clownfish/Vector.h"
+
+#define NOINLINE __attribute__ ((noinline))
+
+typedef size_t (*bench_t)(Obj *obj, uint64_t iterations);
+
+volatile size_t sink;
+
+NOINLINE size_t
+str_get_size(Obj *obj, uint64_t iterations) {
+    String *string = (String*)obj;
+    size_t  sum    = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += Str_Get_Size(string);
+    }
+    return sum;
+}
+
+NOINLINE size_t
+vec_get_size(Obj *obj, uint64_t iterations) {
+    Vector *vector = (Vector*)obj;
+    size_t  sum    = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += Vec_Get_Size(vector);
+    }
+    return sum;
+}
+
+NOINLINE size_t
+str_equals(Obj *obj, uint64_t iterations) {
+    String *string = (String*)obj;
+    size_t  sum    = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += Str_Equals(string, obj);
+    }
+    return sum;
+}
+
+NOINLINE size_t
+obj_equals(Obj *obj, uint64_t iterations) {
+    size_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += Obj_Equals(obj, obj);
+    }
+    return sum;
+}
+
+static void
+bench(bench_t fn, Obj *obj, uint64_t iterations, const char *name) {
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+
+    sink = fn(obj, iterations);
+
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+
+    uint64_t usec = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000
+                    + (t1.tv_usec - t0.tv_usec);
+    printf("ns/call with %s: %f\n", name,
+           (usec * 1000.0) / (double)iterations);
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t iterations;
+    if (argc > 1) {
+        iterations = strtoll(argv[1], NULL, 10);
+    }
+    else {
+        iterations = UINT64_C(100000000);
+    }
+    cfish_bootstrap_parcel();
+
+    String *string = Str_newf("final dispatch");
+    Vector *vector = Vec_new(0);
+
+#ifdef CFISH_DEVIRTUALIZE
+    printf("CFISH_DEVIRTUALIZE defined\n");
+#endif
+    bench(str_get_size, (Obj*)string, iterations, "Str_Get_Size (final)");
+    bench(vec_get_size, (Obj*)vector, iterations, "Vec_Get_Size (final)");
+    bench(str_equals, (Obj*)string, iterations, "Str_Equals (final)");
+    bench(obj_equals, (Obj*)string, iterations, "Obj_Equals (virtual)");
+
+    DECREF(vector);
+    DECREF(string);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Microbenchmark for the guarded direct calls generated for monomorphic
+ * methods, using the MonoObj test class from the TestClownfish parcel.
+ *
+ * The benchmark is compiled twice: `exe` uses vtable dispatch like every
+ * other parcel by default, `exe_devirt` defines CFISH_DEVIRTUALIZE which
+ * enables the class guard and the direct call to the exported implementing
+ * function.  Get_Value_Virtual is the same function without the
+ * "monomorphic" annotation.  Calling Get_Value on a MonoObjSub measures a
+ * guard miss.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "cfish_parcel.h"
+#include "testcfish_parcel.h"
+#include "Clownfish/Obj.h"
+#include "Clownfish/Test/MonoObj.h"
+
+#define NOINLINE __attribute__ ((noinline))
+
+typedef int64_t (*bench_t)(MonoObj *obj, uint64_t iterations);
+
+volatile int64_t sink;
+
+NOINLINE int64_t
+get_value(MonoObj *obj, uint64_t iterations) {
+    int64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += MonoObj_Get_Value(obj);
+    }
+    return sum;
+}
+
+NOINLINE int64_t
+get_value_virtual(MonoObj *obj, uint64_t iterations) {
+    int64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += MonoObj_Get_Value_Virtual(obj);
+    }
+    return sum;
+}
+
+static void
+bench(bench_t fn, MonoObj *obj, uint64_t iterations, const char *name) {
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+
+    sink = fn(obj, iterations);
+
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+
+    uint64_t usec = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000
+                    + (t1.tv_usec - t0.tv_usec);
+    printf("ns/call with %s: %f\n", name,
+           (usec * 1000.0) / (double)iterations);
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t iterations;
+    if (argc > 1) {
+        iterations = strtoll(argv[1], NULL, 10);
+    }
+    else {
+        iterations = UINT64_C(100000000);
+    }
+    testcfish_bootstrap_parcel();
+
+    MonoObj    *mono = MonoObj_new(1);
+    MonoObjSub *sub  = MonoObjSub_new(1);
+
+#ifdef CFISH_DEVIRTUALIZE
+    printf("CFISH_DEVIRTUALIZE defined\n");
+#endif
+    bench(get_value, mono, iterations, "Get_Value (monomorphic, hit)");
+    bench(get_value, (MonoObj*)sub, iterations,
+          "Get_Value (monomorphic, miss)");
+    bench(get_value_virtual, mono, iterations, "Get_Value_Virtual");
+
+    DECREF(sub);
+    DECREF(mono);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Microbenchmarks for INCREF/DECREF and the container methods which are
+ * dominated by refcount traffic.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define CFISH_USE_SHORT_NAMES
+
+#include "cfish_parcel.h"
+#include "Clownfish/Hash.h"
+#include "Clownfish/Num.h"
+#include "Clownfish/Obj.h"
+#include "Clownfish/String.h"
+#include "Clownfish/Vector.h"
+
+#define NOINLINE __attribute__ ((noinline))
+#define NUM_ELEMS 1000
+
+typedef void (*bench_t)(Obj *obj, uint64_t iterations);
+
+NOINLINE void
+incref_decref(Obj *obj, uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+        INCREF(obj);
+        DECREF(obj);
+    }
+}
+
+NOINLINE void
+vec_clone(Obj *obj, uint64_t iterations) {
+    Vector *vec = (Vector*)obj;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        DECREF(Vec_Clone(vec));
+    }
+}
+
+NOINLINE void
+hash_keys(Obj *obj, uint64_t iterations) {
+    Hash *hash = (Hash*)obj;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        DECREF(Hash_Keys(hash));
+    }
+}
+
+static void
+bench(bench_t fn, Obj *obj, uint64_t iterations, uint64_t ops_per_iter,
+      const char *name) {
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+
+    fn(obj, iterations);
+
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+
+    uint64_t usec = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000
+                    + (t1.tv_usec - t0.tv_usec);
+    printf("ns/op with %s: %f\n", name,
+           (usec * 1000.0) / ((double)iterations * ops_per_iter));
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t iterations;
+    if (argc > 1) {
+        iterations = strtoll(argv[1], NULL, 10);
+    }
+    else {
+        iterations = UINT64_C(100000000);
+    }
+    cfish_bootstrap_parcel();
+
+    Obj    *integer = (Obj*)Int_new(42);
+    Obj    *string  = (Obj*)Str_newf("forty-two");
+    Vector *vec     = Vec_new(NUM_ELEMS);
+    Hash   *hash    = Hash_new(NUM_ELEMS);
+    for (int32_t i = 0; i < NUM_ELEMS; ++i) {
+        Vec_Push(vec, (Obj*)Int_new(i));
+        String *key = Str_newf("key %i32", i);
+        Hash_Store(hash, key, (Obj*)Int_new(i));
+        DECREF(key);
+    }
+
+    bench(incref_decref, integer, iterations, 1, "INCREF/DECREF Integer");
+    bench(incref_decref, string, iterations, 1, "INCREF/DECREF String");
+    bench(vec_clone, (Obj*)vec, iterations / NUM_ELEMS, NUM_ELEMS,
+          "Vec_Clone per element");
+    bench(hash_keys, (Obj*)hash, iterations / NUM_ELEMS, NUM_ELEMS,
+          "Hash_Keys per element");
+
+    Obj_make_shared(integer);
+    bench(incref_decref, integer, iterations, 1,
+          "INCREF/DECREF shared Integer");
+
+    DECREF(hash);
+    DECREF(vec);
+    DECREF(string);
+    DECREF(integer);
+    return 0;
+}
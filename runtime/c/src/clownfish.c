@@ -17,6 +17,7 @@
 #define C_CFISH_CLASS
 #define C_CFISH_METHOD
 #define C_CFISH_OBJ
+#define C_CFISH_STRING
 #define CFISH_USE_SHORT_NAMES
 
 #include <setjmp.h>
@@ -37,74 +38,119 @@
 #include "Clownfish/Method.h"
 #include "Clownfish/Num.h"
 #include "Clownfish/String.h"
-#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/HostRuntime.h"
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Vector.h"
 
 /**** Obj ******************************************************************/
 
-static CFISH_INLINE bool
-SI_immortal(cfish_Class *klass) {
+/* Flags in the top bits of the refcount.  Objects without any of them take
+ * the fast path in INCREF and DECREF, which only touches the refcount
+ * itself and not the object's Class.
+ *
+ * SHARED_FLAG:   Object shared between threads, updated atomically.
+ * IMMORTAL_FLAG: Class, Method and Boolean singletons, never freed.
+ * STRING_FLAG:   String which must be copied on INCREF if it wraps an
+ *                external buffer.
+ */
+#define SHARED_FLAG   ((size_t)1 << (sizeof(size_t) * 8 - 1))
+#define IMMORTAL_FLAG ((size_t)1 << (sizeof(size_t) * 8 - 2))
+#define STRING_FLAG   ((size_t)1 << (sizeof(size_t) * 8 - 3))
+#define FLAGS_MASK    (SHARED_FLAG | IMMORTAL_FLAG | STRING_FLAG)
+
+static CFISH_INLINE size_t
+SI_refcount_flags(cfish_Class *klass) {
+    if (klass == CFISH_STRING) {
+        return STRING_FLAG;
+    }
     if (klass == CFISH_CLASS
         || klass == CFISH_METHOD
         || klass == CFISH_BOOLEAN
        ){
-        return true;
+        return IMMORTAL_FLAG;
     }
-    return false;
+    return 0;
 }
 
 static CFISH_INLINE bool
-SI_is_string_type(cfish_Class *klass) {
-    if (klass == CFISH_STRING) {
-        return true;
-    }
-    return false;
+SI_cas_refcount(size_t volatile *target, size_t old_value, size_t new_value) {
+#if CHY_SIZEOF_SIZE_T == 8
+    return Atomic_cas_i64((int64_t volatile*)target, (int64_t)old_value,
+                          (int64_t)new_value);
+#else
+    return Atomic_cas_i32((int32_t volatile*)target, (int32_t)old_value,
+                          (int32_t)new_value);
+#endif
 }
 
 uint32_t
 cfish_get_refcount(void *vself) {
     cfish_Obj *self = (cfish_Obj*)vself;
-    return (uint32_t)self->refcount;
+    return (uint32_t)(self->refcount & ~FLAGS_MASK);
 }
 
 Obj*
 cfish_inc_refcount(void *vself) {
     Obj *self = (Obj*)vself;
+    size_t refcount = self->refcount;
+
+    if (!(refcount & FLAGS_MASK)) {
+        self->refcount = refcount + 1;
+        return self;
+    }
 
     // Handle special cases.
-    cfish_Class *const klass = self->klass;
-    if (klass->flags & CFISH_fREFCOUNTSPECIAL) {
-        if (SI_is_string_type(klass)) {
-            // Only copy-on-incref Strings get special-cased.  Ordinary
-            // strings fall through to the general case.
-            if (CFISH_Str_Is_Copy_On_IncRef((cfish_String*)self)) {
-                const char *utf8 = CFISH_Str_Get_Ptr8((cfish_String*)self);
-                size_t size = CFISH_Str_Get_Size((cfish_String*)self);
-                return (cfish_Obj*)cfish_Str_new_from_trusted_utf8(utf8, size);
-            }
-        }
-        else if (SI_immortal(klass)) {
-            return self;
+    if (refcount & IMMORTAL_FLAG) {
+        return self;
+    }
+    if (refcount & STRING_FLAG) {
+        // Only copy-on-incref Strings get special-cased.  Ordinary
+        // strings fall through to the general case.
+        cfish_String *string = (cfish_String*)self;
+        if (string->origin == NULL) {
+            return (Obj*)Str_new_from_trusted_utf8(string->ptr, string->size);
         }
     }
 
-    self->refcount++;
+    if (refcount & SHARED_FLAG) {
+        Atomic_incr_size(&self->refcount);
+    }
+    else {
+        self->refcount = refcount + 1;
+    }
     return self;
 }
 
 uint32_t
 cfish_dec_refcount(void *vself) {
     cfish_Obj *self = (Obj*)vself;
-    cfish_Class *klass = self->klass;
-    if (klass->flags & CFISH_fREFCOUNTSPECIAL) {
-        if (SI_immortal(klass)) {
-            return (uint32_t)self->refcount;
+    size_t refcount = self->refcount;
+
+    if (refcount & IMMORTAL_FLAG) {
+        return (uint32_t)(refcount & ~FLAGS_MASK);
+    }
+
+    if (refcount & SHARED_FLAG) {
+        // Check the count before decrementing, so that an underflow can't
+        // borrow from the flag bits and leave a corrupted object behind.
+        while (1) {
+            size_t count = refcount & ~FLAGS_MASK;
+            if (count == 0) {
+                THROW(ERR, "Illegal refcount of 0");
+            }
+            if (SI_cas_refcount(&self->refcount, refcount, refcount - 1)) {
+                if (count == 1) {
+                    Obj_Destroy(self);
+                }
+                return (uint32_t)(count - 1);
+            }
+            refcount = *(size_t volatile*)&self->refcount;
         }
     }
 
-    size_t modified_refcount = 0;
-    switch (self->refcount) {
+    size_t modified_refcount = refcount & ~FLAGS_MASK;
+    switch (modified_refcount) {
         case 0:
             THROW(ERR, "Illegal refcount of 0");
             break; // useless
@@ -113,12 +159,22 @@ cfish_dec_refcount(void *vself) {
             Obj_Destroy(self);
             break;
         default:
-            modified_refcount = --self->refcount;
+            modified_refcount--;
+            self->refcount = refcount - 1;
             break;
     }
     return (uint32_t)modified_refcount;
 }
 
+bool
+Obj_make_shared(Obj *self) {
+    if (self->refcount & (IMMORTAL_FLAG | SHARED_FLAG)) {
+        return false;
+    }
+    self->refcount |= SHARED_FLAG;
+    return true;
+}
+
 void*
 Obj_To_Host_IMP(Obj *self, void *vcache) {
     UNUSED_VAR(self);
@@ -133,7 +189,7 @@ Obj*
 Class_Make_Obj_IMP(Class *self) {
     Obj *obj = (Obj*)Memory_wrapped_calloc(self->obj_alloc_size, 1);
     obj->klass = self;
-    obj->refcount = 1;
+    obj->refcount = 1 | SI_refcount_flags(self);
     return obj;
 }
 
@@ -142,7 +198,7 @@ Class_Init_Obj_IMP(Class *self, void *allocation) {
     memset(allocation, 0, self->obj_alloc_size);
     Obj *obj = (Obj*)allocation;
     obj->klass = self;
-    obj->refcount = 1;
+    obj->refcount = 1 | SI_refcount_flags(self);
     return obj;
 }
 
@@ -250,20 +306,20 @@ Err_trap(Err_Attempt_t routine, void *routine_context) {
     return error;
 }
 
-/**** TestUtils ************************************************************/
+/**** HostRuntime **********************************************************/
 
 void*
-cfish_TestUtils_clone_host_runtime() {
+HostRuntime_clone() {
     return NULL;
 }
 
 void
-cfish_TestUtils_set_host_runtime(void *runtime) {
+HostRuntime_set_current(void *runtime) {
     UNUSED_VAR(runtime);
 }
 
 void
-cfish_TestUtils_destroy_host_runtime(void *runtime) {
+HostRuntime_destroy(void *runtime) {
     UNUSED_VAR(runtime);
 }
 
@@ -8836,6 +8836,15 @@ int main(int argc, const char **argv) {
     if (chaz_HeadCheck_defines_symbol("__sync_bool_compare_and_swap", "")) {
         chaz_ConfWriter_add_def("HAS___SYNC_BOOL_COMPARE_AND_SWAP", NULL);
     }
+    if (chaz_CC_test_link(
+            "#include <execinfo.h>\n"
+            "int main() {\n"
+            "    void *addrs[1];\n"
+            "    return backtrace(addrs, 1) < 0;\n"
+            "}\n")
+       ) {
+        chaz_ConfWriter_add_def("HAS_BACKTRACE", NULL);
+    }
     link_flags = S_link_flags(cli);
     chaz_ConfWriter_add_def("EXTRA_LDFLAGS",
                             chaz_CFlags_get_string(link_flags));
@@ -9229,7 +9238,9 @@ cfish_MakeFile_write_c_cfc_rules(cfish_MakeFile *self) {
     rule = chaz_MakeFile_add_rule(self->makefile, self->autogen_target,
                                   cfc_exe);
     chaz_MakeRule_add_prereq(rule, "$(CLOWNFISH_HEADERS)");
-    cfc_command = chaz_Util_join("", cfc_exe, " --charmonic --source=",
+    cfc_command = chaz_Util_join("", cfc_exe,
+                                 " --charmonic --static-vtables",
+                                 " --const-offsets --source=",
                                  self->core_dir, " --source=", self->test_dir,
                                  " --dest=autogen --header=cfc_header", NULL);
     chaz_MakeRule_add_command(rule, cfc_command);
@@ -22,6 +22,8 @@
 #include "Clownfish/Class.h"
 #include "Clownfish/Blob.h"
 #include "Clownfish/Err.h"
+#include "Clownfish/FileMapping.h"
+#include "Clownfish/String.h"
 #include "Clownfish/Util/Memory.h"
 
 Blob*
@@ -35,9 +37,9 @@ Blob_init(Blob *self, const void *bytes, size_t size) {
     char *copy = (char*)MALLOCATE(size);
     memcpy(copy, bytes, size);
 
-    self->buf      = copy;
-    self->size     = size;
-    self->owns_buf = true;
+    self->buf    = copy;
+    self->size   = size;
+    self->origin = (Obj*)self;
 
     return self;
 }
@@ -50,9 +52,9 @@ Blob_new_steal(void *bytes, size_t size) {
 
 Blob*
 Blob_init_steal(Blob *self, void *bytes, size_t size) {
-    self->buf      = (char*)bytes;
-    self->size     = size;
-    self->owns_buf = true;
+    self->buf    = (char*)bytes;
+    self->size   = size;
+    self->origin = (Obj*)self;
 
     return self;
 }
@@ -65,19 +67,57 @@ Blob_new_wrap(const void *bytes, size_t size) {
 
 Blob*
 Blob_init_wrap(Blob *self, const void *bytes, size_t size) {
-    self->buf      = (char*)bytes;
-    self->size     = size;
-    self->owns_buf = false;
+    self->buf    = (char*)bytes;
+    self->size   = size;
+    self->origin = NULL;
 
     return self;
 }
 
+Blob*
+Blob_new_mmap(String *path, int64_t offset, int64_t length, int32_t advice) {
+    FileMapping *mapping = FileMapping_new(path, offset, length, advice);
+    Blob *self = (Blob*)Class_Make_Obj(BLOB);
+    self->buf    = FileMapping_Get_Ptr(mapping);
+    self->size   = FileMapping_Get_Size(mapping);
+    self->origin = (Obj*)mapping;
+    return self;
+}
+
 void
 Blob_Destroy_IMP(Blob *self) {
-    if (self->owns_buf) { FREEMEM((char*)self->buf); }
+    if (self->origin == (Obj*)self) {
+        FREEMEM((char*)self->buf);
+    }
+    else {
+        DECREF(self->origin);
+    }
     SUPER_DESTROY(self, BLOB);
 }
 
+Blob*
+Blob_Slice_IMP(Blob *self, size_t offset, size_t length) {
+    // Adjust ranges if necessary.
+    if (offset >= self->size) {
+        offset = 0;
+        length = 0;
+    }
+    else if (length > self->size - offset) {
+        length = self->size - offset;
+    }
+
+    if (self->origin == NULL) {
+        // Copy slices of wrapped Blobs.
+        return Blob_new(self->buf + offset, length);
+    }
+
+    Blob *slice = (Blob*)Class_Make_Obj(BLOB);
+    slice->buf    = self->buf + offset;
+    slice->size   = length;
+    slice->origin = INCREF(self->origin);
+    return slice;
+}
+
 Blob*
 Blob_Clone_IMP(Blob *self) {
     return (Blob*)INCREF(self);
@@ -15,6 +15,7 @@
  */
 
 #define C_CFISH_BYTEBUF
+#define C_CFISH_BLOB
 #define CFISH_USE_SHORT_NAMES
 
 #include <stdlib.h>
@@ -39,6 +40,18 @@ SI_add_grow_and_oversize(ByteBuf *self, size_t size, size_t extra);
 static void
 S_grow_and_oversize(ByteBuf *self, size_t min_size);
 
+// Reallocate the buffer to `capacity` bytes, moving to a private copy if
+// the current buffer is shared with views.
+static void
+S_realloc(ByteBuf *self, size_t capacity);
+
+// Make sure that the buffer isn't shared with views before it's modified.
+static CFISH_INLINE void
+SI_unshare(ByteBuf *self);
+
+static void
+S_unshare(ByteBuf *self);
+
 // Not inlining the THROW macro reduces code size and complexity of
 // SI_add_grow_and_oversize.
 static void
@@ -57,9 +70,10 @@ BB_init(ByteBuf *self, size_t min_cap) {
     // Check for overflow.
     if (capacity < min_cap) { capacity = SIZE_MAX; }
 
-    self->buf  = (char*)MALLOCATE(capacity);
-    self->size = 0;
-    self->cap  = capacity;
+    self->buf    = (char*)MALLOCATE(capacity);
+    self->size   = 0;
+    self->cap    = capacity;
+    self->shared = NULL;
     return self;
 }
 
@@ -76,9 +90,10 @@ BB_init_bytes(ByteBuf *self, const void *bytes, size_t size) {
     // Check for overflow.
     if (capacity < size) { capacity = SIZE_MAX; }
 
-    self->buf  = (char*)MALLOCATE(capacity);
-    self->size = size;
-    self->cap  = capacity;
+    self->buf    = (char*)MALLOCATE(capacity);
+    self->size   = size;
+    self->cap    = capacity;
+    self->shared = NULL;
     memcpy(self->buf, bytes, size);
     return self;
 }
@@ -92,15 +107,21 @@ BB_new_steal_bytes(void *bytes, size_t size, size_t capacity) {
 ByteBuf*
 BB_init_steal_bytes(ByteBuf *self, void *bytes, size_t size,
                     size_t capacity) {
-    self->buf  = (char*)bytes;
-    self->size = size;
-    self->cap  = capacity;
+    self->buf    = (char*)bytes;
+    self->size   = size;
+    self->cap    = capacity;
+    self->shared = NULL;
     return self;
 }
 
 void
 BB_Destroy_IMP(ByteBuf *self) {
-    FREEMEM(self->buf);
+    if (self->shared) {
+        DECREF(self->shared);
+    }
+    else {
+        FREEMEM(self->buf);
+    }
     SUPER_DESTROY(self, BYTEBUF);
 }
 
@@ -115,6 +136,7 @@ BB_Set_Size_IMP(ByteBuf *self, size_t size) {
         THROW(ERR, "Can't set size to %u64 (greater than capacity of %u64)",
               (uint64_t)size, (uint64_t)self->cap);
     }
+    SI_unshare(self);
     self->size = size;
 }
 
@@ -155,6 +177,7 @@ BB_Equals_Bytes_IMP(ByteBuf *self, const void *bytes, size_t size) {
 static CFISH_INLINE void
 SI_cat_bytes(ByteBuf *self, const void *bytes, size_t size) {
     SI_add_grow_and_oversize(self, self->size, size);
+    SI_unshare(self);
     memcpy(self->buf + self->size, bytes, size);
     self->size += size;
 }
@@ -177,19 +200,53 @@ BB_Grow_IMP(ByteBuf *self, size_t min_cap) {
         // Check for overflow.
         if (capacity < min_cap) { capacity = SIZE_MAX; }
 
-        self->buf = (char*)REALLOCATE(self->buf, capacity);
-        self->cap = capacity;
+        S_realloc(self, capacity);
+    }
+    else {
+        // The caller is going to write into the buffer.
+        SI_unshare(self);
     }
 
     return self->buf;
 }
 
+Blob*
+BB_View_IMP(ByteBuf *self, size_t offset, size_t length) {
+    if (self->shared == NULL) {
+        // Hand the buffer over to a Blob which outlives reallocations.
+        self->shared = Blob_new_steal(self->buf, self->cap);
+    }
+    else {
+        // The ByteBuf may have grown within its capacity.
+        self->shared->size = self->cap;
+    }
+
+    if (offset >= self->size) {
+        offset = 0;
+        length = 0;
+    }
+    else if (length > self->size - offset) {
+        length = self->size - offset;
+    }
+
+    return Blob_Slice(self->shared, offset, length);
+}
+
 Blob*
 BB_Yield_Blob_IMP(ByteBuf *self) {
-    Blob *blob = Blob_new_steal(self->buf, self->size);
-    self->buf  = NULL;
-    self->size = 0;
-    self->cap  = 0;
+    Blob *blob;
+    if (self->shared) {
+        // Views keep pointing into the shared Blob, so yield it directly.
+        blob = self->shared;
+        blob->size = self->size;
+    }
+    else {
+        blob = Blob_new_steal(self->buf, self->size);
+    }
+    self->buf    = NULL;
+    self->size   = 0;
+    self->cap    = 0;
+    self->shared = NULL;
     return blob;
 }
 
@@ -241,10 +298,54 @@ S_grow_and_oversize(ByteBuf *self, size_t min_size) {
     // Check for overflow.
     if (capacity < min_size) { capacity = SIZE_MAX; }
 
-    self->buf = (char*)REALLOCATE(self->buf, capacity);
+    S_realloc(self, capacity);
+}
+
+static void
+S_realloc(ByteBuf *self, size_t capacity) {
+    Blob *shared = self->shared;
+
+    if (shared != NULL && cfish_get_refcount(shared) > 1) {
+        // Copy directly into a buffer of the new capacity.
+        char *copy = (char*)MALLOCATE(capacity);
+        memcpy(copy, self->buf, self->size);
+        DECREF(shared);
+        self->shared = NULL;
+        self->buf    = copy;
+    }
+    else {
+        SI_unshare(self);
+        self->buf = (char*)REALLOCATE(self->buf, capacity);
+    }
+
     self->cap = capacity;
 }
 
+static CFISH_INLINE void
+SI_unshare(ByteBuf *self) {
+    if (self->shared != NULL) {
+        S_unshare(self);
+    }
+}
+
+static void
+S_unshare(ByteBuf *self) {
+    Blob *shared = self->shared;
+
+    if (cfish_get_refcount(shared) == 1) {
+        // All views are gone. Take the buffer back.
+        shared->origin = NULL;
+    }
+    else {
+        char *copy = (char*)MALLOCATE(self->cap);
+        memcpy(copy, self->buf, self->size);
+        self->buf = copy;
+    }
+
+    DECREF(shared);
+    self->shared = NULL;
+}
+
 static void
 S_overflow_error() {
     THROW(ERR, "ByteBuf buffer overflow");
@@ -32,6 +32,7 @@
 #include "Clownfish/Hash.h"
 #include "Clownfish/LockFreeRegistry.h"
 #include "Clownfish/Method.h"
+#include "Clownfish/PtrHash.h"
 #include "Clownfish/Vector.h"
 #include "Clownfish/Util/Atomic.h"
 #include "Clownfish/Util/Memory.h"
@@ -49,9 +50,16 @@ S_set_name(Class *self, const char *utf8, size_t size);
 static Method*
 S_find_method(Class *self, const char *meth_name);
 
+static void
+S_set_method_offset(const ClassSpec *spec, uint32_t *offset_ptr,
+                    uint32_t offset);
+
 static LockFreeRegistry *Class_registry;
 cfish_Class_bootstrap_hook1_t cfish_Class_bootstrap_hook1;
 
+/* Round up to the alignment of Class, Method and String structs. */
+#define ALIGN_SIZE(size) (((size) + 7) & ~(uint32_t)7)
+
 void
 Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
     const ClassSpec          *specs            = parcel_spec->class_specs;
@@ -61,16 +69,31 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
     uint32_t num_classes = parcel_spec->num_classes;
 
     /* Pass 1:
-     * - Allocate memory.
+     * - Compute the size of all Class structs.
+     * - Allocate memory for all classes in a single block.
      * - Initialize global Class pointers.
      */
+    uint32_t *class_alloc_sizes
+        = (uint32_t*)MALLOCATE(num_classes * sizeof(uint32_t));
+    PtrHash *spec_index = PtrHash_new(num_classes);
+    uint32_t total_class_size = 0;
+    uint32_t total_novel      = 0;
+
     for (uint32_t i = 0; i < num_classes; ++i) {
         const ClassSpec *spec = &specs[i];
-        Class *parent = NULL;
+        uint32_t novel_offset = offsetof(Class, vtable);
 
         if (spec->parent) {
-            parent = *spec->parent;
-            if (!parent) {
+            // Parents in the same parcel don't have a Class struct yet.
+            void *parent_index = PtrHash_Fetch(spec_index, spec->parent);
+            if (parent_index) {
+                novel_offset
+                    = class_alloc_sizes[(uintptr_t)parent_index - 1];
+            }
+            else if (*spec->parent) {
+                novel_offset = (*spec->parent)->class_alloc_size;
+            }
+            else {
                 // Wrong order of class specs or inheritance cycle.
                 fprintf(stderr, "Parent class of '%s' not initialized\n",
                         spec->name);
@@ -78,31 +101,47 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
             }
         }
 
-        uint32_t novel_offset = parent
-                                ? parent->class_alloc_size
-                                : offsetof(Class, vtable);
-        uint32_t class_alloc_size = novel_offset
-                                    + spec->num_novel_meths
-                                      * (uint32_t)sizeof(cfish_method_t);
+        class_alloc_sizes[i] = novel_offset
+                               + spec->num_novel_meths
+                                 * (uint32_t)sizeof(cfish_method_t);
+        total_class_size += ALIGN_SIZE(class_alloc_sizes[i]);
+        total_novel      += spec->num_novel_meths;
+        PtrHash_Store(spec_index, spec->klass, (void*)(uintptr_t)(i + 1));
+    }
 
-        Class *klass = (Class*)CALLOCATE(class_alloc_size, 1);
+    PtrHash_Destroy(spec_index);
+
+    char *class_block = (char*)CALLOCATE(total_class_size, 1);
+    char *class_ptr   = class_block;
+    bool  class_block_used = false;
+
+    for (uint32_t i = 0; i < num_classes; ++i) {
+        const ClassSpec *spec = &specs[i];
+        Class *klass = (Class*)class_ptr;
+        class_ptr += ALIGN_SIZE(class_alloc_sizes[i]);
 
         // Needed to calculate size of subclasses.
-        klass->class_alloc_size = class_alloc_size;
+        klass->class_alloc_size = class_alloc_sizes[i];
 
         // Initialize the global pointer to the Class.
-        if (!Atomic_cas_ptr((void**)spec->klass, NULL, klass)) {
-            // Another thread beat us to it.
-            FREEMEM(klass);
+        if (Atomic_cas_ptr((void**)spec->klass, NULL, klass)) {
+            class_block_used = true;
         }
+        // Otherwise, another thread beat us to it.
+    }
+
+    if (!class_block_used) {
+        FREEMEM(class_block);
     }
+    FREEMEM(class_alloc_sizes);
 
     /* Pass 2:
      * - Initialize IVARS_OFFSET.
      * - Initialize 'klass' ivar and refcount by calling Init_Obj.
      * - Initialize parent, flags, obj_alloc_size, class_alloc_size.
      * - Assign parcel_spec.
-     * - Initialize method pointers and offsets.
+     * - Initialize method pointers and offsets, or copy precomputed
+     *   vtables.
      */
     uint32_t num_novel      = 0;
     uint32_t num_overridden = 0;
@@ -157,6 +196,17 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
             klass->flags |= CFISH_fEMPTY;
         }
 
+        if (spec->vtable) {
+            // The vtable was resolved at compile time and the method
+            // offsets were initialized statically.
+            memcpy(klass->vtable, spec->vtable,
+                   klass->class_alloc_size - offsetof(Class, vtable));
+            num_inherited  += spec->num_inherited_meths;
+            num_overridden += spec->num_overridden_meths;
+            num_novel      += spec->num_novel_meths;
+            continue;
+        }
+
         if (parent) {
             // Copy parent vtable.
             uint32_t parent_vt_size = parent->class_alloc_size
@@ -166,13 +216,13 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
 
         for (size_t i = 0; i < spec->num_inherited_meths; ++i) {
             const InheritedMethSpec *mspec = &inherited_specs[num_inherited++];
-            *mspec->offset = *mspec->parent_offset;
+            S_set_method_offset(spec, mspec->offset, *mspec->parent_offset);
         }
 
         for (size_t i = 0; i < spec->num_overridden_meths; ++i) {
             const OverriddenMethSpec *mspec
                 = &overridden_specs[num_overridden++];
-            *mspec->offset = *mspec->parent_offset;
+            S_set_method_offset(spec, mspec->offset, *mspec->parent_offset);
             Class_Override_IMP(klass, mspec->func, *mspec->offset);
         }
 
@@ -182,7 +232,7 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
 
         for (size_t i = 0; i < spec->num_novel_meths; ++i) {
             const NovelMethSpec *mspec = &novel_specs[num_novel++];
-            *mspec->offset = novel_offset;
+            S_set_method_offset(spec, mspec->offset, novel_offset);
             novel_offset += (uint32_t)sizeof(cfish_method_t);
             Class_Override_IMP(klass, mspec->func, *mspec->offset);
         }
@@ -193,53 +243,78 @@ Class_bootstrap(const cfish_ParcelSpec *parcel_spec) {
      * Pass 3:
      * - Inititalize name and method array.
      * - Register class.
+     *
+     * Methods, method arrays and names of all classes are carved out of
+     * a single block.  Names wrap the static strings in the class and
+     * method specs.  They must never be INCREFed without copying, which
+     * wrapped Strings guarantee.
+     *
+     * None of these objects may ever reach Destroy, which would FREEMEM a
+     * pointer into the middle of the block.  Every host must keep them
+     * alive forever: the C and Go runtimes flag Class and Method objects
+     * as immortal, Perl exempts them from refcounting, and under Python
+     * the reference created by Class_Init_Obj is never released.
      */
-    num_novel      = 0;
-    num_overridden = 0;
-    num_inherited  = 0;
+    uint32_t method_size = ALIGN_SIZE(METHOD->obj_alloc_size);
+    uint32_t string_size = ALIGN_SIZE(STRING->obj_alloc_size);
+    size_t   total_size  = total_novel * (size_t)method_size
+                           + (total_novel + num_classes) * (size_t)string_size
+                           + (total_novel + num_classes) * sizeof(Method*);
+    char *block     = (char*)CALLOCATE(total_size, 1);
+    char *block_ptr = block;
+    bool  block_used = false;
+
+    if (Class_registry == NULL) {
+        Class_init_registry();
+    }
+
+    num_novel = 0;
     for (uint32_t i = 0; i < num_classes; ++i) {
         const ClassSpec *spec = &specs[i];
         Class *klass = *spec->klass;
 
-        String *name_internal
-            = Str_new_from_trusted_utf8(spec->name, strlen(spec->name));
-        if (!Atomic_cas_ptr((void**)&klass->name_internal, NULL,
-                            name_internal)
-           ) {
-            DECREF(name_internal);
-            name_internal = klass->name_internal;
+        String *name = (String*)Class_Init_Obj(STRING, block_ptr);
+        block_ptr += string_size;
+        Str_init_wrap_trusted_utf8(name, spec->name, strlen(spec->name));
+        if (Atomic_cas_ptr((void**)&klass->name, NULL, name)) {
+            block_used = true;
         }
 
-        String *name = Str_new_wrap_trusted_utf8(Str_Get_Ptr8(name_internal),
-                                                 Str_Get_Size(name_internal));
-        if (!Atomic_cas_ptr((void**)&klass->name, NULL, name)) {
-            DECREF(name);
-            name = klass->name;
-        }
-
-        Method **methods = (Method**)MALLOCATE((spec->num_novel_meths + 1)
-                                               * sizeof(Method*));
+        Method **methods = (Method**)block_ptr;
+        block_ptr += (spec->num_novel_meths + 1) * sizeof(Method*);
 
         // Only store novel methods for now.
         for (size_t i = 0; i < spec->num_novel_meths; ++i) {
             const NovelMethSpec *mspec = &novel_specs[num_novel++];
-            String *name = SSTR_WRAP_C(mspec->name);
-            Method *method = Method_new(name, mspec->callback_func,
-                                        *mspec->offset);
+
+            String *meth_name = (String*)Class_Init_Obj(STRING, block_ptr);
+            block_ptr += string_size;
+            Str_init_wrap_trusted_utf8(meth_name, mspec->name,
+                                       strlen(mspec->name));
+
+            Method *method = (Method*)Class_Init_Obj(METHOD, block_ptr);
+            block_ptr += method_size;
+            method->name          = meth_name;
+            method->callback_func = mspec->callback_func;
+            method->offset        = *mspec->offset;
+
             methods[i] = method;
         }
 
         methods[spec->num_novel_meths] = NULL;
 
-        if (!Atomic_cas_ptr((void**)&klass->methods, NULL, methods)) {
-            // Another thread beat us to it.
-            for (size_t i = 0; i < spec->num_novel_meths; ++i) {
-                Method_Destroy(methods[i]);
-            }
-            FREEMEM(methods);
+        if (Atomic_cas_ptr((void**)&klass->methods, NULL, methods)) {
+            block_used = true;
         }
+        // Otherwise, another thread beat us to it.
+
+        // The registry rejects duplicates itself, so there's no need for
+        // the extra lookup in Class_add_to_registry.
+        LFReg_register(Class_registry, klass->name, (Obj*)klass);
+    }
 
-        Class_add_to_registry(klass);
+    if (!block_used) {
+        FREEMEM(block);
     }
 }
 
@@ -283,7 +358,7 @@ Class_Get_Methods_IMP(Class *self) {
 
 void
 Class_init_registry() {
-    LockFreeRegistry *reg = LFReg_new(256);
+    LockFreeRegistry *reg = LFReg_new(1024);
     if (Atomic_cas_ptr((void*volatile*)&Class_registry, NULL, reg)) {
         return;
     }
@@ -456,11 +531,16 @@ S_set_name(Class *self, const char *utf8, size_t size) {
     /*
      * We use a "wrapped" String for `name` because it's effectively
      * threadsafe: the sole reference is owned by an immortal object and any
-     * INCREF spawns a copy.
+     * INCREF spawns a copy.  As with bootstrapped classes, the String and
+     * the characters it wraps share an allocation which is never freed.
      */
-    self->name_internal = Str_new_from_trusted_utf8(utf8, size);
-    self->name = Str_new_wrap_trusted_utf8(Str_Get_Ptr8(self->name_internal),
-                                           Str_Get_Size(self->name_internal));
+    uint32_t string_size = ALIGN_SIZE(STRING->obj_alloc_size);
+    char *block = (char*)MALLOCATE(string_size + size + 1);
+    char *chars = block + string_size;
+    memcpy(chars, utf8, size);
+    chars[size] = '\0';
+    String *name = (String*)Class_Init_Obj(STRING, block);
+    self->name = Str_init_wrap_trusted_utf8(name, chars, size);
 }
 
 static Method*
@@ -477,3 +557,23 @@ S_find_method(Class *self, const char *name) {
     return NULL;
 }
 
+/* Method offsets may have been initialized with constants computed by CFC
+ * from the headers of prerequisite parcels.  If they differ from the actual
+ * layout, code compiled against them would call the wrong methods.
+ *
+ * This is fatal rather than an exception: it is detected in the middle of
+ * bootstrapping, after the Class pointers of the parcel have already been
+ * published, so there is no consistent state to recover to.
+ */
+static void
+S_set_method_offset(const ClassSpec *spec, uint32_t *offset_ptr,
+                    uint32_t offset) {
+    if (*offset_ptr != 0 && *offset_ptr != offset) {
+        fprintf(stderr, "Vtable layout of class '%s' doesn't match the"
+                " headers it was compiled against, recompile the parcel\n",
+                spec->name);
+        abort();
+    }
+    *offset_ptr = offset;
+}
+
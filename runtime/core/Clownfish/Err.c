@@ -24,11 +24,17 @@
 #include <string.h>
 #include <stdio.h>
 
+#ifdef CHY_HAS_BACKTRACE
+  #include <execinfo.h>
+  #include <stdlib.h>
+#endif
+
 #include "Clownfish/Err.h"
 
 #include "Clownfish/CharBuf.h"
 #include "Clownfish/String.h"
 #include "Clownfish/Class.h"
+#include "Clownfish/Util/Atomic.h"
 #include "Clownfish/Util/Memory.h"
 
 Err*
@@ -37,25 +43,60 @@ Err_new(String *mess) {
     return Err_init(self, mess);
 }
 
+static bool capture_native_backtraces = false;
+
+static ErrTrace_t*
+S_get_trace(Err *self);
+
+static String*
+S_full_mess(Err *self);
+
+static void
+S_flush_trace(Err *self);
+
+static void
+S_cat_frame(CharBuf *buf, const char *file, int line, const char *func);
+
 Err*
 Err_init(Err *self, String *mess) {
     self->mess = mess;
+#ifdef CHY_HAS_BACKTRACE
+    if (capture_native_backtraces) {
+        ErrTrace_t *trace = S_get_trace(self);
+        int num_addrs = backtrace(trace->addrs, ERR_MAX_ADDRS);
+        trace->num_addrs = num_addrs > 0 ? (uint32_t)num_addrs : 0;
+    }
+#endif
     return self;
 }
 
+bool
+Err_capture_backtraces(bool enable) {
+#ifdef CHY_HAS_BACKTRACE
+    capture_native_backtraces = enable;
+    return true;
+#else
+    UNUSED_VAR(enable);
+    return false;
+#endif
+}
+
 void
 Err_Destroy_IMP(Err *self) {
     DECREF(self->mess);
+    DECREF(self->full_mess);
+    FREEMEM(self->trace);
     SUPER_DESTROY(self, ERR);
 }
 
 String*
 Err_To_String_IMP(Err *self) {
-    return (String*)INCREF(self->mess);
+    return (String*)INCREF(S_full_mess(self));
 }
 
 void
 Err_Cat_Mess_IMP(Err *self, String *mess) {
+    S_flush_trace(self);
     String *new_mess = Str_Cat(self->mess, mess);
     DECREF(self->mess);
     self->mess = new_mess;
@@ -126,6 +167,15 @@ S_vmake_mess(const char *file, int line, const char *func,
     return message;
 }
 
+static String*
+S_vformat(const char *pattern, va_list args) {
+    CharBuf *buf = CB_new(strlen(pattern) + 30);
+    CB_VCatF(buf, pattern, args);
+    String *message = CB_Yield_String(buf);
+    DECREF(buf);
+    return message;
+}
+
 String*
 Err_make_mess(const char *file, int line, const char *func,
               const char *pattern, ...) {
@@ -148,33 +198,178 @@ Err_warn_at(const char *file, int line, const char *func,
 
 String*
 Err_Get_Mess_IMP(Err *self) {
-    return self->mess;
+    return S_full_mess(self);
 }
 
 void
 Err_Add_Frame_IMP(Err *self, const char *file, int line, const char *func) {
-    CharBuf *buf = CB_new(0);
-    CB_Cat(buf, self->mess);
+    // Native stack addresses are always listed last, so keep them pending
+    // unless they are already part of the cached message.
+    ErrTrace_t *trace = self->trace;
+    uint32_t num_addrs = 0;
+    if (trace && !self->full_mess) {
+        num_addrs = trace->num_addrs;
+        trace->num_addrs = 0;
+    }
+    S_flush_trace(self);
 
+    // `file` and `func` may not outlive the call, so format the frame now.
+    CharBuf *buf = CB_new(Str_Get_Size(self->mess) + 64);
+    CB_Cat(buf, self->mess);
     if (!Str_Ends_With_Utf8(self->mess, "\n", 1)) {
         CB_Cat_Char(buf, '\n');
     }
+    S_cat_frame(buf, file, line, func);
+    DECREF(self->mess);
+    self->mess = CB_Yield_String(buf);
+    DECREF(buf);
+
+    if (trace) {
+        trace->num_addrs = num_addrs;
+    }
+}
+
+void
+Err_Add_Static_Frame_IMP(Err *self, const char *file, int line,
+                         const char *func) {
+    ErrTrace_t *trace = S_get_trace(self);
+    if (self->full_mess || trace->num_frames == ERR_MAX_FRAMES) {
+        S_flush_trace(self);
+    }
+    ErrFrame *frame = &trace->frames[trace->num_frames++];
+    frame->file = file;
+    frame->func = func;
+    frame->line = line;
+}
+
+#ifdef CHY_HAS_BACKTRACE
+static void
+S_cat_native_frames(CharBuf *buf, void **addrs, uint32_t num_addrs) {
+    char **symbols = backtrace_symbols(addrs, (int)num_addrs);
+    if (!symbols) { return; }
+
+    CB_Cat_Trusted_Utf8(buf, "Native backtrace:\n", 18);
+    for (uint32_t i = 0; i < num_addrs; i++) {
+        // Symbol names aren't guaranteed to be valid UTF-8.
+        char *symbol = symbols[i];
+        for (size_t j = 0; symbol[j] != '\0'; j++) {
+            if ((unsigned char)symbol[j] >= 0x80) { symbol[j] = '?'; }
+        }
+        CB_Cat_Trusted_Utf8(buf, "\t", 1);
+        CB_Cat_Trusted_Utf8(buf, symbol, strlen(symbol));
+        CB_Cat_Trusted_Utf8(buf, "\n", 1);
+    }
+
+    free(symbols);
+}
+#endif
+
+static ErrTrace_t*
+S_get_trace(Err *self) {
+    if (self->trace == NULL) {
+        self->trace = (ErrTrace_t*)CALLOCATE(1, sizeof(ErrTrace_t));
+    }
+    return self->trace;
+}
 
+static void
+S_cat_frame(CharBuf *buf, const char *file, int line, const char *func) {
     if (func != NULL) {
         CB_catf(buf, "\t%s at %s line %i32\n", func, file, (int32_t)line);
     }
     else {
         CB_catf(buf, "\tat %s line %i32\n", file, (int32_t)line);
     }
+}
 
-    DECREF(self->mess);
-    self->mess = CB_Yield_String(buf);
+// Return a new message with pending frames and native stack addresses
+// appended.
+static String*
+S_format_trace(String *mess, ErrTrace_t *trace) {
+    CharBuf *buf = CB_new(Str_Get_Size(mess) + trace->num_frames * 64);
+    CB_Cat(buf, mess);
+
+    if (!Str_Ends_With_Utf8(mess, "\n", 1)) {
+        CB_Cat_Char(buf, '\n');
+    }
+
+    for (uint32_t i = 0; i < trace->num_frames; i++) {
+        ErrFrame *frame = &trace->frames[i];
+        S_cat_frame(buf, frame->file, frame->line, frame->func);
+    }
+
+#ifdef CHY_HAS_BACKTRACE
+    if (trace->num_addrs) {
+        S_cat_native_frames(buf, trace->addrs, trace->num_addrs);
+    }
+#endif
+
+    String *full_mess = CB_Yield_String(buf);
     DECREF(buf);
+    return full_mess;
+}
+
+// Return the complete message without modifying `mess` or `trace`.  The
+// formatted message is cached in `full_mess` with a CAS, so concurrent
+// readers of a shared Err agree on a single String and never free one
+// another's result.
+static String*
+S_full_mess(Err *self) {
+    String *full_mess
+        = (String*)Atomic_load_acquire_ptr((void*volatile*)&self->full_mess);
+    if (full_mess) { return full_mess; }
+
+    ErrTrace_t *trace = self->trace;
+    if (trace == NULL || (trace->num_frames == 0 && trace->num_addrs == 0)) {
+        return self->mess;
+    }
+
+    full_mess = S_format_trace(self->mess, trace);
+    if (!Atomic_cas_ptr((void*volatile*)&self->full_mess, NULL, full_mess)) {
+        DECREF(full_mess);
+        full_mess = (String*)Atomic_load_acquire_ptr(
+                        (void*volatile*)&self->full_mess);
+    }
+    return full_mess;
+}
+
+// Fold pending frames into `mess` before the Err is modified.  Only called
+// from the thread which owns the Err.
+static void
+S_flush_trace(Err *self) {
+    String *full_mess = S_full_mess(self);
+    if (full_mess != self->mess) {
+        INCREF(full_mess);
+        DECREF(self->mess);
+        self->mess = full_mess;
+    }
+    DECREF(self->full_mess);
+    self->full_mess = NULL;
+    if (self->trace) {
+        self->trace->num_frames = 0;
+        self->trace->num_addrs  = 0;
+    }
+}
+
+Err*
+Err_attempt(Err_Try_t routine, void *context) {
+    if (routine(context)) {
+        return NULL;
+    }
+
+    Err *error = (Err*)INCREF(Err_get_error());
+    if (error) {
+        Err_set_error(NULL);
+    }
+    else {
+        error = Err_new(Str_newf("Routine failed without setting an error"));
+    }
+    return error;
 }
 
 void
 Err_rethrow(Err *self, const char *file, int line, const char *func) {
-    Err_Add_Frame_IMP(self, file, line, func);
+    Err_Add_Static_Frame_IMP(self, file, line, func);
     Err_do_throw(self);
 }
 
@@ -184,11 +379,12 @@ Err_throw_at(Class *klass, const char *file, int line,
     va_list args;
 
     va_start(args, pattern);
-    String *message = S_vmake_mess(file, line, func, pattern, args);
+    String *message = S_vformat(pattern, args);
     va_end(args);
 
     Err *err = (Err*)Class_Make_Obj(klass);
     err = Err_init(err, message);
+    Err_Add_Static_Frame_IMP(err, file, line, func);
     Err_do_throw(err);
 }
 
@@ -0,0 +1,281 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_FILEMAPPING
+#define CFISH_USE_SHORT_NAMES
+
+#include "charmony.h"
+
+#include <string.h>
+
+#include "Clownfish/FileMapping.h"
+#include "Clownfish/Blob.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/String.h"
+#include "Clownfish/Util/Memory.h"
+
+// Platform-specific: map the region described by `offset` and `length` into
+// `self`.  Return an error message or NULL on success.
+static String*
+S_map_file(FileMapping *self, String *path, int64_t offset, int64_t length,
+           int32_t advice);
+
+FileMapping*
+FileMapping_new(String *path, int64_t offset, int64_t length,
+                int32_t advice) {
+    FileMapping *self = (FileMapping*)Class_Make_Obj(FILEMAPPING);
+    return FileMapping_init(self, path, offset, length, advice);
+}
+
+FileMapping*
+FileMapping_init(FileMapping *self, String *path, int64_t offset,
+                 int64_t length, int32_t advice) {
+    self->base     = NULL;
+    self->map_size = 0;
+    self->ptr      = (char*)"";
+    self->size     = 0;
+
+    String *error = S_map_file(self, path, offset, length, advice);
+    if (error) {
+        DECREF(self);
+        Err_throw_mess(ERR, error);
+    }
+
+    return self;
+}
+
+// Validate the requested region against the size of the file. Resolve a
+// negative `length` and return the offset rounded down to `granularity`.
+static String*
+S_check_region(String *path, int64_t file_size, int64_t granularity,
+               int64_t offset, int64_t *length, int64_t *aligned_offset) {
+    if (offset < 0 || offset > file_size) {
+        return Str_newf("Offset %i64 out of range for '%o' (size %i64)",
+                        offset, path, file_size);
+    }
+    if (*length < 0) {
+        *length = file_size - offset;
+    }
+    else if (*length > file_size - offset) {
+        return Str_newf("Region %i64+%i64 out of range for '%o' (size %i64)",
+                        offset, *length, path, file_size);
+    }
+    if ((uint64_t)*length > SIZE_MAX) {
+        return Str_newf("Region of %i64 bytes too large to map", *length);
+    }
+    // Mappings must start at a multiple of the page size or allocation
+    // granularity.
+    *aligned_offset = offset - offset % granularity;
+    return NULL;
+}
+
+const char*
+FileMapping_Get_Ptr_IMP(FileMapping *self) {
+    return self->ptr;
+}
+
+size_t
+FileMapping_Get_Size_IMP(FileMapping *self) {
+    return self->size;
+}
+
+/********************************* WINDOWS ********************************/
+#if defined(CHY_HAS_WINDOWS_H)
+
+#include <windows.h>
+
+static String*
+S_map_file(FileMapping *self, String *path, int64_t offset, int64_t length,
+           int32_t advice) {
+    // Windows has no equivalent of madvise for file views.
+    UNUSED_VAR(advice);
+
+    char *path_utf8 = Str_To_Utf8(path);
+    int wide_len = MultiByteToWideChar(CP_UTF8, 0, path_utf8, -1, NULL, 0);
+    wchar_t *wide = (wchar_t*)MALLOCATE((size_t)wide_len * sizeof(wchar_t));
+    MultiByteToWideChar(CP_UTF8, 0, path_utf8, -1, wide, wide_len);
+    HANDLE file = CreateFileW(wide, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    FREEMEM(wide);
+    FREEMEM(path_utf8);
+    if (file == INVALID_HANDLE_VALUE) {
+        return Str_newf("Can't open '%o': error %u32", path,
+                        (uint32_t)GetLastError());
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return Str_newf("Can't get size of '%o': error %u32", path,
+                        (uint32_t)GetLastError());
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int64_t aligned_offset = 0;
+    String *error
+        = S_check_region(path, (int64_t)file_size.QuadPart,
+                         (int64_t)info.dwAllocationGranularity, offset,
+                         &length, &aligned_offset);
+    if (error || length == 0) {
+        CloseHandle(file);
+        return error;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0,
+                                        NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return Str_newf("Can't map '%o': error %u32", path,
+                        (uint32_t)GetLastError());
+    }
+
+    // The view keeps the mapping object alive.
+    size_t   lead     = (size_t)(offset - aligned_offset);
+    size_t   map_size = lead + (size_t)length;
+    uint64_t off      = (uint64_t)aligned_offset;
+    void *base = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(off >> 32),
+                               (DWORD)(off & 0xFFFFFFFF), map_size);
+    CloseHandle(mapping);
+    if (base == NULL) {
+        return Str_newf("Can't map '%o': error %u32", path,
+                        (uint32_t)GetLastError());
+    }
+
+    self->base     = (char*)base;
+    self->map_size = map_size;
+    self->ptr      = self->base + lead;
+    self->size     = (size_t)length;
+    return NULL;
+}
+
+void
+FileMapping_Destroy_IMP(FileMapping *self) {
+    if (self->base) {
+        UnmapViewOfFile(self->base);
+    }
+    SUPER_DESTROY(self, FILEMAPPING);
+}
+
+/********************************* POSIX **********************************/
+#elif defined(CHY_HAS_SYS_MMAN_H) && defined(CHY_HAS_UNISTD_H) \
+      && defined(CHY_HAS_FCNTL_H) && defined(CHY_HAS_SYS_STAT_H)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static String*
+S_map_file(FileMapping *self, String *path, int64_t offset, int64_t length,
+           int32_t advice) {
+    char *path_utf8 = Str_To_Utf8(path);
+    int fd = open(path_utf8, O_RDONLY);
+    FREEMEM(path_utf8);
+    if (fd < 0) {
+        return Str_newf("Can't open '%o': %s", path, strerror(errno));
+    }
+
+    struct stat stat_buf;
+    if (fstat(fd, &stat_buf) != 0) {
+        String *error = Str_newf("Can't stat '%o': %s", path,
+                                 strerror(errno));
+        close(fd);
+        return error;
+    }
+
+    int64_t aligned_offset = 0;
+    String *error
+        = S_check_region(path, (int64_t)stat_buf.st_size,
+                         (int64_t)sysconf(_SC_PAGESIZE), offset, &length,
+                         &aligned_offset);
+    if (error == NULL && (int64_t)(off_t)aligned_offset != aligned_offset) {
+        error = Str_newf("Offset %i64 too large to map", offset);
+    }
+    if (error || length == 0) {
+        close(fd);
+        return error;
+    }
+
+    size_t lead     = (size_t)(offset - aligned_offset);
+    size_t map_size = lead + (size_t)length;
+    void *base = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd,
+                      (off_t)aligned_offset);
+    if (base == MAP_FAILED) {
+        error = Str_newf("Can't map '%o': %s", path, strerror(errno));
+        close(fd);
+        return error;
+    }
+    // The mapping stays valid after closing the descriptor.
+    close(fd);
+
+    switch (advice) {
+#ifdef MADV_SEQUENTIAL
+        case CFISH_MMAP_SEQUENTIAL:
+            madvise(base, map_size, MADV_SEQUENTIAL);
+            break;
+#endif
+#ifdef MADV_RANDOM
+        case CFISH_MMAP_RANDOM:
+            madvise(base, map_size, MADV_RANDOM);
+            break;
+#endif
+#ifdef MADV_WILLNEED
+        case CFISH_MMAP_WILLNEED:
+            madvise(base, map_size, MADV_WILLNEED);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    self->base     = (char*)base;
+    self->map_size = map_size;
+    self->ptr      = self->base + lead;
+    self->size     = (size_t)length;
+    return NULL;
+}
+
+void
+FileMapping_Destroy_IMP(FileMapping *self) {
+    if (self->base) {
+        munmap(self->base, self->map_size);
+    }
+    SUPER_DESTROY(self, FILEMAPPING);
+}
+
+/******************************** FALLBACK *********************************/
+#else
+
+static String*
+S_map_file(FileMapping *self, String *path, int64_t offset, int64_t length,
+           int32_t advice) {
+    UNUSED_VAR(self);
+    UNUSED_VAR(offset);
+    UNUSED_VAR(length);
+    UNUSED_VAR(advice);
+    return Str_newf("Can't map '%o': memory-mapped files not supported",
+                    path);
+}
+
+void
+FileMapping_Destroy_IMP(FileMapping *self) {
+    SUPER_DESTROY(self, FILEMAPPING);
+}
+
+#endif
@@ -95,6 +95,19 @@ Hash_Destroy_IMP(Hash *self) {
     SUPER_DESTROY(self, HASH);
 }
 
+void
+Hash_Share_IMP(Hash *self) {
+    if (!Obj_make_shared((Obj*)self)) { return; }
+
+    HashEntry *entry       = (HashEntry*)self->entries;
+    HashEntry *const limit = entry + self->capacity;
+    for (; entry < limit; entry++) {
+        if (!entry->key || entry->key == TOMBSTONE) { continue; }
+        Obj_Share((Obj*)entry->key);
+        if (entry->value) { Obj_Share(entry->value); }
+    }
+}
+
 void
 Hash_Clear_IMP(Hash *self) {
     HashEntry *entry       = (HashEntry*)self->entries;
@@ -0,0 +1,597 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_NUMARRAY
+#define C_CFISH_I32ARRAY
+#define C_CFISH_I64ARRAY
+#define C_CFISH_F64ARRAY
+#define CFISH_USE_SHORT_NAMES
+
+#include <string.h>
+
+#include "Clownfish/NumArray.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/Memory.h"
+#include "Clownfish/Util/SortUtils.h"
+
+// Make room for at least `min_size` elements, oversizing by 25% but at least
+// four elements.
+static void
+S_reserve(NumArray *self, size_t min_size);
+
+// Extend the array to `tick + 1` elements, zero-filling the gap.
+static void
+S_extend(NumArray *self, size_t tick);
+
+// Copy `size` elements from `nums` into an empty array.
+static void
+S_copy_from(NumArray *self, const void *nums, size_t size);
+
+// Clamp a range to the size of the array.
+static void
+S_clamp_range(NumArray *self, size_t *offset, size_t *length);
+
+static void
+S_sort(NumArray *self, CFISH_Sort_Compare_t compare);
+
+static void
+S_overflow_error(void);
+
+static void
+S_out_of_bounds_error(size_t tick, size_t size);
+
+static void
+S_empty_error(const char *op);
+
+/**************************** Clownfish::NumArray ****************************/
+
+NumArray*
+NumArr_init(NumArray *self, size_t capacity, size_t width) {
+    if (capacity > SIZE_MAX / width) {
+        S_overflow_error();
+    }
+    self->size    = 0;
+    self->cap     = capacity;
+    self->width   = width;
+    self->exports = 0;
+    self->elems   = CALLOCATE(capacity, width);
+    ABSTRACT_CLASS_CHECK(self, NUMARRAY);
+    return self;
+}
+
+void
+NumArr_add_export(NumArray *self) {
+    Atomic_fetch_add_i32(&self->exports, 1);
+}
+
+void
+NumArr_remove_export(NumArray *self) {
+    Atomic_fetch_sub_i32(&self->exports, 1);
+}
+
+void
+NumArr_Destroy_IMP(NumArray *self) {
+    FREEMEM(self->elems);
+    SUPER_DESTROY(self, NUMARRAY);
+}
+
+void
+NumArr_Grow_IMP(NumArray *self, size_t capacity) {
+    if (capacity > self->cap) {
+        if (capacity > SIZE_MAX / self->width) {
+            S_overflow_error();
+        }
+        if (Atomic_load_acquire_i32(&self->exports)) {
+            THROW(ERR, "Can't reallocate %o while its buffer is exported",
+                  Obj_get_class_name((Obj*)self));
+        }
+        self->elems = REALLOCATE(self->elems, capacity * self->width);
+        self->cap   = capacity;
+    }
+}
+
+void
+NumArr_Resize_IMP(NumArray *self, size_t size) {
+    if (size > self->size) {
+        NumArr_Grow(self, size);
+        memset((char*)self->elems + self->size * self->width, 0,
+               (size - self->size) * self->width);
+    }
+    self->size = size;
+}
+
+size_t
+NumArr_Get_Size_IMP(NumArray *self) {
+    return self->size;
+}
+
+size_t
+NumArr_Get_Capacity_IMP(NumArray *self) {
+    return self->cap;
+}
+
+bool
+NumArr_Equals_IMP(NumArray *self, Obj *other) {
+    NumArray *twin = (NumArray*)other;
+    if (twin == self)                                      { return true; }
+    if (Obj_get_class(other) != Obj_get_class((Obj*)self)) { return false; }
+    if (twin->size != self->size)                          { return false; }
+    return self->size == 0
+           || memcmp(self->elems, twin->elems, self->size * self->width) == 0;
+}
+
+/**************************** Clownfish::I32Array ****************************/
+
+static int
+S_compare_int32(void *context, const void *va, const void *vb);
+
+I32Array*
+I32Arr_new(size_t capacity) {
+    I32Array *self = (I32Array*)Class_Make_Obj(I32ARRAY);
+    return I32Arr_init(self, capacity);
+}
+
+I32Array*
+I32Arr_new_from(const int32_t *nums, size_t size) {
+    I32Array *self = I32Arr_new(size);
+    S_copy_from((NumArray*)self, nums, size);
+    return self;
+}
+
+I32Array*
+I32Arr_init(I32Array *self, size_t capacity) {
+    NumArr_init((NumArray*)self, capacity, sizeof(int32_t));
+    return self;
+}
+
+void
+I32Arr_Push_IMP(I32Array *self, int32_t value) {
+    if (self->size == self->cap) {
+        S_reserve((NumArray*)self, self->size + 1);
+    }
+    ((int32_t*)self->elems)[self->size++] = value;
+}
+
+int32_t
+I32Arr_Fetch_IMP(I32Array *self, size_t tick) {
+    if (tick >= self->size) {
+        S_out_of_bounds_error(tick, self->size);
+    }
+    return ((int32_t*)self->elems)[tick];
+}
+
+void
+I32Arr_Store_IMP(I32Array *self, size_t tick, int32_t value) {
+    if (tick >= self->size) {
+        S_extend((NumArray*)self, tick);
+    }
+    ((int32_t*)self->elems)[tick] = value;
+}
+
+int32_t*
+I32Arr_Get_Ptr_IMP(I32Array *self) {
+    return (int32_t*)self->elems;
+}
+
+void
+I32Arr_Sort_IMP(I32Array *self) {
+    S_sort((NumArray*)self, S_compare_int32);
+}
+
+I32Array*
+I32Arr_Slice_IMP(I32Array *self, size_t offset, size_t length) {
+    S_clamp_range((NumArray*)self, &offset, &length);
+    return I32Arr_new_from((int32_t*)self->elems + offset, length);
+}
+
+int64_t
+I32Arr_Sum_IMP(I32Array *self) {
+    // Accumulate in unsigned arithmetic, which wraps instead of invoking
+    // undefined behavior on overflow.
+    const int32_t *elems = (const int32_t*)self->elems;
+    uint64_t sum = 0;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        sum += (uint64_t)elems[i];
+    }
+    return (int64_t)sum;
+}
+
+int32_t
+I32Arr_Min_IMP(I32Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Min");
+    }
+    const int32_t *elems = (const int32_t*)self->elems;
+    int32_t min = elems[0];
+    for (size_t i = 1, max = self->size; i < max; i++) {
+        min = elems[i] < min ? elems[i] : min;
+    }
+    return min;
+}
+
+int32_t
+I32Arr_Max_IMP(I32Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Max");
+    }
+    const int32_t *elems = (const int32_t*)self->elems;
+    int32_t max = elems[0];
+    for (size_t i = 1, limit = self->size; i < limit; i++) {
+        max = elems[i] > max ? elems[i] : max;
+    }
+    return max;
+}
+
+void
+I32Arr_Scale_IMP(I32Array *self, int32_t factor) {
+    int32_t *elems = (int32_t*)self->elems;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        elems[i] = (int32_t)((uint32_t)elems[i] * (uint32_t)factor);
+    }
+}
+
+I32Array*
+I32Arr_Clone_IMP(I32Array *self) {
+    return I32Arr_new_from((int32_t*)self->elems, self->size);
+}
+
+static int
+S_compare_int32(void *context, const void *va, const void *vb) {
+    int32_t a = *(const int32_t*)va;
+    int32_t b = *(const int32_t*)vb;
+    UNUSED_VAR(context);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+/**************************** Clownfish::I64Array ****************************/
+
+static int
+S_compare_int64(void *context, const void *va, const void *vb);
+
+I64Array*
+I64Arr_new(size_t capacity) {
+    I64Array *self = (I64Array*)Class_Make_Obj(I64ARRAY);
+    return I64Arr_init(self, capacity);
+}
+
+I64Array*
+I64Arr_new_from(const int64_t *nums, size_t size) {
+    I64Array *self = I64Arr_new(size);
+    S_copy_from((NumArray*)self, nums, size);
+    return self;
+}
+
+I64Array*
+I64Arr_init(I64Array *self, size_t capacity) {
+    NumArr_init((NumArray*)self, capacity, sizeof(int64_t));
+    return self;
+}
+
+void
+I64Arr_Push_IMP(I64Array *self, int64_t value) {
+    if (self->size == self->cap) {
+        S_reserve((NumArray*)self, self->size + 1);
+    }
+    ((int64_t*)self->elems)[self->size++] = value;
+}
+
+int64_t
+I64Arr_Fetch_IMP(I64Array *self, size_t tick) {
+    if (tick >= self->size) {
+        S_out_of_bounds_error(tick, self->size);
+    }
+    return ((int64_t*)self->elems)[tick];
+}
+
+void
+I64Arr_Store_IMP(I64Array *self, size_t tick, int64_t value) {
+    if (tick >= self->size) {
+        S_extend((NumArray*)self, tick);
+    }
+    ((int64_t*)self->elems)[tick] = value;
+}
+
+int64_t*
+I64Arr_Get_Ptr_IMP(I64Array *self) {
+    return (int64_t*)self->elems;
+}
+
+void
+I64Arr_Sort_IMP(I64Array *self) {
+    S_sort((NumArray*)self, S_compare_int64);
+}
+
+I64Array*
+I64Arr_Slice_IMP(I64Array *self, size_t offset, size_t length) {
+    S_clamp_range((NumArray*)self, &offset, &length);
+    return I64Arr_new_from((int64_t*)self->elems + offset, length);
+}
+
+int64_t
+I64Arr_Sum_IMP(I64Array *self) {
+    // Accumulate in unsigned arithmetic, which wraps instead of invoking
+    // undefined behavior on overflow.
+    const int64_t *elems = (const int64_t*)self->elems;
+    uint64_t sum = 0;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        sum += (uint64_t)elems[i];
+    }
+    return (int64_t)sum;
+}
+
+int64_t
+I64Arr_Min_IMP(I64Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Min");
+    }
+    const int64_t *elems = (const int64_t*)self->elems;
+    int64_t min = elems[0];
+    for (size_t i = 1, max = self->size; i < max; i++) {
+        min = elems[i] < min ? elems[i] : min;
+    }
+    return min;
+}
+
+int64_t
+I64Arr_Max_IMP(I64Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Max");
+    }
+    const int64_t *elems = (const int64_t*)self->elems;
+    int64_t max = elems[0];
+    for (size_t i = 1, limit = self->size; i < limit; i++) {
+        max = elems[i] > max ? elems[i] : max;
+    }
+    return max;
+}
+
+void
+I64Arr_Scale_IMP(I64Array *self, int64_t factor) {
+    int64_t *elems = (int64_t*)self->elems;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        elems[i] = (int64_t)((uint64_t)elems[i] * (uint64_t)factor);
+    }
+}
+
+I64Array*
+I64Arr_Clone_IMP(I64Array *self) {
+    return I64Arr_new_from((int64_t*)self->elems, self->size);
+}
+
+static int
+S_compare_int64(void *context, const void *va, const void *vb) {
+    int64_t a = *(const int64_t*)va;
+    int64_t b = *(const int64_t*)vb;
+    UNUSED_VAR(context);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+/**************************** Clownfish::F64Array ****************************/
+
+static int
+S_compare_double(void *context, const void *va, const void *vb);
+
+F64Array*
+F64Arr_new(size_t capacity) {
+    F64Array *self = (F64Array*)Class_Make_Obj(F64ARRAY);
+    return F64Arr_init(self, capacity);
+}
+
+F64Array*
+F64Arr_new_from(const double *nums, size_t size) {
+    F64Array *self = F64Arr_new(size);
+    S_copy_from((NumArray*)self, nums, size);
+    return self;
+}
+
+F64Array*
+F64Arr_init(F64Array *self, size_t capacity) {
+    NumArr_init((NumArray*)self, capacity, sizeof(double));
+    return self;
+}
+
+void
+F64Arr_Push_IMP(F64Array *self, double value) {
+    if (self->size == self->cap) {
+        S_reserve((NumArray*)self, self->size + 1);
+    }
+    ((double*)self->elems)[self->size++] = value;
+}
+
+double
+F64Arr_Fetch_IMP(F64Array *self, size_t tick) {
+    if (tick >= self->size) {
+        S_out_of_bounds_error(tick, self->size);
+    }
+    return ((double*)self->elems)[tick];
+}
+
+void
+F64Arr_Store_IMP(F64Array *self, size_t tick, double value) {
+    if (tick >= self->size) {
+        S_extend((NumArray*)self, tick);
+    }
+    ((double*)self->elems)[tick] = value;
+}
+
+double*
+F64Arr_Get_Ptr_IMP(F64Array *self) {
+    return (double*)self->elems;
+}
+
+void
+F64Arr_Sort_IMP(F64Array *self) {
+    S_sort((NumArray*)self, S_compare_double);
+}
+
+F64Array*
+F64Arr_Slice_IMP(F64Array *self, size_t offset, size_t length) {
+    S_clamp_range((NumArray*)self, &offset, &length);
+    return F64Arr_new_from((double*)self->elems + offset, length);
+}
+
+double
+F64Arr_Sum_IMP(F64Array *self) {
+    // Four independent accumulators break the dependency chain between
+    // additions, which lets the compiler pipeline and vectorize the loop.
+    const double *elems = (const double*)self->elems;
+    const size_t  size  = self->size;
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        sum0 += elems[i];
+        sum1 += elems[i + 1];
+        sum2 += elems[i + 2];
+        sum3 += elems[i + 3];
+    }
+    for (; i < size; i++) {
+        sum0 += elems[i];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+double
+F64Arr_Min_IMP(F64Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Min");
+    }
+    const double *elems = (const double*)self->elems;
+    double min = elems[0];
+    for (size_t i = 1, max = self->size; i < max; i++) {
+        min = elems[i] < min ? elems[i] : min;
+    }
+    return min;
+}
+
+double
+F64Arr_Max_IMP(F64Array *self) {
+    if (self->size == 0) {
+        S_empty_error("Max");
+    }
+    const double *elems = (const double*)self->elems;
+    double max = elems[0];
+    for (size_t i = 1, limit = self->size; i < limit; i++) {
+        max = elems[i] > max ? elems[i] : max;
+    }
+    return max;
+}
+
+void
+F64Arr_Scale_IMP(F64Array *self, double factor) {
+    double *elems = (double*)self->elems;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        elems[i] *= factor;
+    }
+}
+
+bool
+F64Arr_Equals_IMP(F64Array *self, Obj *other) {
+    F64Array *twin = (F64Array*)other;
+    if (twin == self)                { return true; }
+    if (!Obj_is_a(other, F64ARRAY)) { return false; }
+    if (twin->size != self->size)    { return false; }
+    const double *elems      = (const double*)self->elems;
+    const double *twin_elems = (const double*)twin->elems;
+    for (size_t i = 0, max = self->size; i < max; i++) {
+        if (elems[i] != twin_elems[i]) { return false; }
+    }
+    return true;
+}
+
+F64Array*
+F64Arr_Clone_IMP(F64Array *self) {
+    return F64Arr_new_from((double*)self->elems, self->size);
+}
+
+static int
+S_compare_double(void *context, const void *va, const void *vb) {
+    double a = *(const double*)va;
+    double b = *(const double*)vb;
+    UNUSED_VAR(context);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+/****************************** Shared helpers *******************************/
+
+static void
+S_reserve(NumArray *self, size_t min_size) {
+    size_t max_size = SIZE_MAX / self->width;
+    if (min_size > max_size) {
+        S_overflow_error();
+    }
+    size_t extra = min_size / 4;
+    if (extra < 4) { extra = 4; }
+    NumArr_Grow(self, extra > max_size - min_size
+                      ? max_size : min_size + extra);
+}
+
+static void
+S_extend(NumArray *self, size_t tick) {
+    if (tick >= SIZE_MAX / self->width) {
+        S_overflow_error();
+    }
+    if (tick >= self->cap) {
+        S_reserve(self, tick + 1);
+    }
+    memset((char*)self->elems + self->size * self->width, 0,
+           (tick - self->size) * self->width);
+    self->size = tick + 1;
+}
+
+static void
+S_copy_from(NumArray *self, const void *nums, size_t size) {
+    if (size) {
+        memcpy(self->elems, nums, size * self->width);
+    }
+    self->size = size;
+}
+
+static void
+S_clamp_range(NumArray *self, size_t *offset, size_t *length) {
+    if (*offset >= self->size) {
+        *offset = 0;
+        *length = 0;
+    }
+    else if (*length > self->size - *offset) {
+        *length = self->size - *offset;
+    }
+}
+
+static void
+S_sort(NumArray *self, CFISH_Sort_Compare_t compare) {
+    void *scratch = MALLOCATE(self->size * self->width);
+    Sort_mergesort(self->elems, scratch, self->size, self->width, compare,
+                   NULL);
+    FREEMEM(scratch);
+}
+
+static void
+S_overflow_error() {
+    THROW(ERR, "Array index overflow");
+}
+
+static void
+S_out_of_bounds_error(size_t tick, size_t size) {
+    THROW(ERR, "Index %u64 out of bounds (size %u64)", (uint64_t)tick,
+          (uint64_t)size);
+}
+
+static void
+S_empty_error(const char *op) {
+    THROW(ERR, "Can't compute %s of empty array", op);
+}
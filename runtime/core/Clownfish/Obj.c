@@ -85,6 +85,11 @@ Obj_certify(Obj *self, Class *klass, const char *file, int line,
     return self;
 }
 
+void
+Obj_Share_IMP(Obj *self) {
+    Obj_make_shared(self);
+}
+
 bool
 Obj_Equals_IMP(Obj *self, Obj *other) {
     return (self == other);
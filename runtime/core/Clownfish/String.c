@@ -29,6 +29,7 @@
 #include "Clownfish/ByteBuf.h"
 #include "Clownfish/CharBuf.h"
 #include "Clownfish/Err.h"
+#include "Clownfish/FileMapping.h"
 #include "Clownfish/Util/Memory.h"
 
 #define STACK_ITER(string, byte_offset) \
@@ -237,7 +238,7 @@ Str_init_from_trusted_utf8(String *self, const char *utf8, size_t size) {
     // Assign.
     self->ptr    = ptr;
     self->size   = size;
-    self->origin = self;
+    self->origin = (Obj*)self;
 
     return self;
 }
@@ -259,7 +260,7 @@ String*
 Str_init_steal_trusted_utf8(String *self, char *utf8, size_t size) {
     self->ptr    = utf8;
     self->size   = size;
-    self->origin = self;
+    self->origin = (Obj*)self;
     return self;
 }
 
@@ -290,6 +291,28 @@ Str_init_wrap_trusted_utf8(String *self, const char *ptr, size_t size) {
     return self;
 }
 
+String*
+Str_new_mmap_utf8(String *path, int64_t offset, int64_t length,
+                  int32_t advice) {
+    String *self = Str_new_mmap_trusted_utf8(path, offset, length, advice);
+    if (!Str_utf8_valid(self->ptr, self->size)) {
+        DECREF(self);
+        THROW(ERR, "Invalid UTF-8 in '%o'", path);
+    }
+    return self;
+}
+
+String*
+Str_new_mmap_trusted_utf8(String *path, int64_t offset, int64_t length,
+                          int32_t advice) {
+    FileMapping *mapping = FileMapping_new(path, offset, length, advice);
+    String *self = (String*)Class_Make_Obj(STRING);
+    self->ptr    = FileMapping_Get_Ptr(mapping);
+    self->size   = FileMapping_Get_Size(mapping);
+    self->origin = (Obj*)mapping;
+    return self;
+}
+
 String*
 Str_new_from_char(int32_t code_point) {
     const size_t MAX_UTF8_BYTES = 4;
@@ -300,7 +323,7 @@ Str_new_from_char(int32_t code_point) {
     String *self = (String*)Class_Make_Obj(STRING);
     self->ptr    = ptr;
     self->size   = size;
-    self->origin = self;
+    self->origin = (Obj*)self;
     return self;
 }
 
@@ -327,7 +350,7 @@ S_new_substring(String *string, size_t byte_offset, size_t size) {
     else {
         self->ptr    = string->ptr + byte_offset;
         self->size   = size;
-        self->origin = (String*)INCREF(string->origin);
+        self->origin = INCREF(string->origin);
     }
 
     return self;
@@ -340,7 +363,7 @@ Str_Is_Copy_On_IncRef_IMP(String *self) {
 
 void
 Str_Destroy_IMP(String *self) {
-    if (self->origin == self) {
+    if (self->origin == (Obj*)self) {
         FREEMEM((char*)self->ptr);
     }
     else {
@@ -26,6 +26,7 @@
 #include "Clownfish/CharBuf.h"
 #include "Clownfish/Err.h"
 #include "Clownfish/String.h"
+#include "Clownfish/Util/HostRuntime.h"
 #include "Clownfish/Util/Memory.h"
 
 uint64_t
@@ -183,6 +184,21 @@ TestUtils_usleep(uint64_t microseconds) {
 #endif // OS switch.
 
 
+void*
+TestUtils_clone_host_runtime() {
+    return HostRuntime_clone();
+}
+
+void
+TestUtils_set_host_runtime(void *runtime) {
+    HostRuntime_set_current(runtime);
+}
+
+void
+TestUtils_destroy_host_runtime(void *runtime) {
+    HostRuntime_destroy(runtime);
+}
+
 /********************************** Windows ********************************/
 #if !defined(CFISH_NOTHREADS) && defined(CHY_HAS_WINDOWS_H)
 
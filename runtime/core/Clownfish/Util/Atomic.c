@@ -32,6 +32,93 @@ cfish_Atomic_wrapped_cas_ptr(void *volatile *target, void *old_value,
            == old_value;
 }
 
+size_t
+cfish_Atomic_wrapped_incr_size(size_t volatile *target) {
+#if CHY_SIZEOF_SIZE_T == 8
+    return (size_t)InterlockedIncrement64((LONGLONG volatile*)target);
+#else
+    return (size_t)InterlockedIncrement((LONG volatile*)target);
+#endif
+}
+
+size_t
+cfish_Atomic_wrapped_decr_size(size_t volatile *target) {
+#if CHY_SIZEOF_SIZE_T == 8
+    return (size_t)InterlockedDecrement64((LONGLONG volatile*)target);
+#else
+    return (size_t)InterlockedDecrement((LONG volatile*)target);
+#endif
+}
+
+bool
+cfish_Atomic_wrapped_cas_i32(int32_t volatile *target, int32_t old_value,
+                             int32_t new_value) {
+    return InterlockedCompareExchange((LONG volatile*)target, new_value,
+                                      old_value)
+           == old_value;
+}
+
+bool
+cfish_Atomic_wrapped_cas_i64(int64_t volatile *target, int64_t old_value,
+                             int64_t new_value) {
+    return InterlockedCompareExchange64((LONGLONG volatile*)target,
+                                        new_value, old_value)
+           == old_value;
+}
+
+int32_t
+cfish_Atomic_wrapped_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    return (int32_t)InterlockedExchangeAdd((LONG volatile*)target, value);
+}
+
+int64_t
+cfish_Atomic_wrapped_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    return (int64_t)InterlockedExchangeAdd64((LONGLONG volatile*)target,
+                                             value);
+}
+
+/* The Interlocked functions are full barriers, so they also provide the
+ * acquire and release semantics of plain loads and stores.
+ */
+
+int32_t
+cfish_Atomic_wrapped_load_acquire_i32(int32_t volatile *target) {
+    return (int32_t)InterlockedCompareExchange((LONG volatile*)target, 0, 0);
+}
+
+int64_t
+cfish_Atomic_wrapped_load_acquire_i64(int64_t volatile *target) {
+    return (int64_t)InterlockedCompareExchange64((LONGLONG volatile*)target,
+                                                 0, 0);
+}
+
+void*
+cfish_Atomic_wrapped_load_acquire_ptr(void *volatile *target) {
+    return InterlockedCompareExchangePointer(target, NULL, NULL);
+}
+
+void
+cfish_Atomic_wrapped_store_release_i32(int32_t volatile *target,
+                                       int32_t value) {
+    InterlockedExchange((LONG volatile*)target, value);
+}
+
+void
+cfish_Atomic_wrapped_store_release_i64(int64_t volatile *target,
+                                       int64_t value) {
+    InterlockedExchange64((LONGLONG volatile*)target, value);
+}
+
+void
+cfish_Atomic_wrapped_store_release_ptr(void *volatile *target, void *value) {
+    InterlockedExchangePointer(target, value);
+}
+
+void
+cfish_Atomic_wrapped_fence(void) {
+    MemoryBarrier();
+}
+
 /************************** Fall back to ptheads ***************************/
 #elif defined(CHY_HAS_PTHREAD_H)
 
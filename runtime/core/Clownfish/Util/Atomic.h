@@ -31,6 +31,99 @@ extern "C" {
 static CFISH_INLINE bool
 cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value);
 
+/** Compare and swap a 32-bit integer.  See `cas_ptr`.
+ */
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value);
+
+/** Compare and swap a 64-bit integer.  See `cas_ptr`.
+ */
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value);
+
+/** Atomically increment the value at `target` without ordering constraints
+ * and return the new value.
+ */
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target);
+
+/** Atomically decrement the value at `target` with acquire-release
+ * semantics and return the new value.
+ */
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target);
+
+/** Atomically add `value` to the integer at `target` and return the
+ * previous value.  Acts as a full memory barrier.
+ */
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value);
+
+/** Atomically subtract `value` from the integer at `target` and return
+ * the previous value.  Acts as a full memory barrier.
+ */
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value);
+
+/** 64-bit version of `fetch_add_i32`.
+ */
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value);
+
+/** 64-bit version of `fetch_sub_i32`.
+ */
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value);
+
+/** Load the value at `target` with acquire semantics: no memory access
+ * after the load can be reordered before it.
+ */
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target);
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target);
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target);
+
+/** Store `value` at `target` with release semantics: no memory access
+ * before the store can be reordered after it.
+ */
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value);
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value);
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value);
+
+/** Acquire fence.  Loads before the fence are ordered before all memory
+ * accesses after it.
+ */
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void);
+
+/** Release fence.  Memory accesses before the fence are ordered before
+ * stores after it.
+ */
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void);
+
+/** Full, sequentially consistent memory fence.
+ */
+static CFISH_INLINE void
+cfish_Atomic_fence(void);
+
+/** Tell the CPU that the calling thread is busy-waiting.  This is a
+ * scheduling hint, not a memory barrier.
+ */
+static CFISH_INLINE void
+cfish_Atomic_pause(void);
+
 /************************** Single threaded *******************************/
 #ifdef CFISH_NOTHREADS
 
@@ -45,6 +138,110 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     }
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    if (*target == old_value) {
+        *target = new_value;
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    if (*target == old_value) {
+        *target = new_value;
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    return ++*target;
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    return --*target;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    int32_t retval = *target;
+    *target = retval + value;
+    return retval;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    int32_t retval = *target;
+    *target = retval - value;
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    int64_t retval = *target;
+    *target = retval + value;
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    int64_t retval = *target;
+    *target = retval - value;
+    return retval;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    return *target;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    return *target;
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    return *target;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+}
+
 /**************************** C11 stdatomic.h *****************************/
 #elif defined(CHY_HAS_STDATOMIC_H)
 #include <stdatomic.h>
@@ -55,6 +252,105 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
                                           new_value);
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    return atomic_compare_exchange_strong(
+               (volatile atomic_int_least32_t*)target, &old_value,
+               new_value);
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    return atomic_compare_exchange_strong(
+               (volatile atomic_int_least64_t*)target, &old_value,
+               new_value);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    return atomic_fetch_add_explicit((volatile atomic_size_t*)target, 1,
+                                     memory_order_relaxed) + 1;
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    return atomic_fetch_sub_explicit((volatile atomic_size_t*)target, 1,
+                                     memory_order_acq_rel) - 1;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    return atomic_fetch_add((volatile atomic_int_least32_t*)target, value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return atomic_fetch_sub((volatile atomic_int_least32_t*)target, value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    return atomic_fetch_add((volatile atomic_int_least64_t*)target, value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return atomic_fetch_sub((volatile atomic_int_least64_t*)target, value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    return atomic_load_explicit((volatile atomic_int_least32_t*)target,
+                                memory_order_acquire);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    return atomic_load_explicit((volatile atomic_int_least64_t*)target,
+                                memory_order_acquire);
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    return atomic_load_explicit((void *_Atomic *)target,
+                                memory_order_acquire);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    atomic_store_explicit((volatile atomic_int_least32_t*)target, value,
+                          memory_order_release);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    atomic_store_explicit((volatile atomic_int_least64_t*)target, value,
+                          memory_order_release);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    atomic_store_explicit((void *_Atomic *)target, value,
+                          memory_order_release);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    atomic_thread_fence(memory_order_acquire);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    atomic_thread_fence(memory_order_release);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
 /************************** Mac OS X 10.4 and later ***********************/
 #elif defined(CHY_HAS_OSATOMIC_CAS_PTR)
 #include <libkern/OSAtomic.h>
@@ -64,6 +360,113 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     return OSAtomicCompareAndSwapPtr(old_value, new_value, target);
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    return OSAtomicCompareAndSwap32Barrier(old_value, new_value, target);
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    return OSAtomicCompareAndSwap64Barrier(old_value, new_value, target);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+#if CHY_SIZEOF_SIZE_T == 8
+    return (size_t)OSAtomicIncrement64((volatile int64_t*)target);
+#else
+    return (size_t)OSAtomicIncrement32((volatile int32_t*)target);
+#endif
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+#if CHY_SIZEOF_SIZE_T == 8
+    return (size_t)OSAtomicDecrement64Barrier((volatile int64_t*)target);
+#else
+    return (size_t)OSAtomicDecrement32Barrier((volatile int32_t*)target);
+#endif
+}
+
+// OSAtomicAdd* return the new value.
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    return OSAtomicAdd32Barrier(value, target) - value;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return OSAtomicAdd32Barrier(-value, target) + value;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    return OSAtomicAdd64Barrier(value, target) - value;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return OSAtomicAdd64Barrier(-value, target) + value;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    int32_t retval = *target;
+    OSMemoryBarrier();
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    // Plain 64-bit loads may tear on 32-bit CPUs.
+    return OSAtomicAdd64Barrier(0, target);
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    void *retval = *target;
+    OSMemoryBarrier();
+    return retval;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    OSMemoryBarrier();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    int64_t old_value;
+    do {
+        old_value = *target;
+    } while (!OSAtomicCompareAndSwap64Barrier(old_value, value, target));
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    OSMemoryBarrier();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    OSMemoryBarrier();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    OSMemoryBarrier();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    OSMemoryBarrier();
+}
+
 /********************************** Windows *******************************/
 #elif defined(CHY_HAS_WINDOWS_H)
 
@@ -71,20 +474,283 @@ CFISH_VISIBLE bool
 cfish_Atomic_wrapped_cas_ptr(void *volatile *target, void *old_value,
                             void *new_value);
 
+CFISH_VISIBLE bool
+cfish_Atomic_wrapped_cas_i32(int32_t volatile *target, int32_t old_value,
+                             int32_t new_value);
+
+CFISH_VISIBLE bool
+cfish_Atomic_wrapped_cas_i64(int64_t volatile *target, int64_t old_value,
+                             int64_t new_value);
+
+CFISH_VISIBLE size_t
+cfish_Atomic_wrapped_incr_size(size_t volatile *target);
+
+CFISH_VISIBLE size_t
+cfish_Atomic_wrapped_decr_size(size_t volatile *target);
+
+CFISH_VISIBLE int32_t
+cfish_Atomic_wrapped_fetch_add_i32(int32_t volatile *target, int32_t value);
+
+CFISH_VISIBLE int64_t
+cfish_Atomic_wrapped_fetch_add_i64(int64_t volatile *target, int64_t value);
+
+CFISH_VISIBLE int32_t
+cfish_Atomic_wrapped_load_acquire_i32(int32_t volatile *target);
+
+CFISH_VISIBLE int64_t
+cfish_Atomic_wrapped_load_acquire_i64(int64_t volatile *target);
+
+CFISH_VISIBLE void*
+cfish_Atomic_wrapped_load_acquire_ptr(void *volatile *target);
+
+CFISH_VISIBLE void
+cfish_Atomic_wrapped_store_release_i32(int32_t volatile *target,
+                                       int32_t value);
+
+CFISH_VISIBLE void
+cfish_Atomic_wrapped_store_release_i64(int64_t volatile *target,
+                                       int64_t value);
+
+CFISH_VISIBLE void
+cfish_Atomic_wrapped_store_release_ptr(void *volatile *target, void *value);
+
+CFISH_VISIBLE void
+cfish_Atomic_wrapped_fence(void);
+
 static CFISH_INLINE bool
 cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     return cfish_Atomic_wrapped_cas_ptr(target, old_value, new_value);
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    return cfish_Atomic_wrapped_cas_i32(target, old_value, new_value);
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    return cfish_Atomic_wrapped_cas_i64(target, old_value, new_value);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    return cfish_Atomic_wrapped_incr_size(target);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    return cfish_Atomic_wrapped_decr_size(target);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    return cfish_Atomic_wrapped_fetch_add_i32(target, value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return cfish_Atomic_wrapped_fetch_add_i32(target, -value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    return cfish_Atomic_wrapped_fetch_add_i64(target, value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return cfish_Atomic_wrapped_fetch_add_i64(target, -value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    return cfish_Atomic_wrapped_load_acquire_i32(target);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    return cfish_Atomic_wrapped_load_acquire_i64(target);
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    return cfish_Atomic_wrapped_load_acquire_ptr(target);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    cfish_Atomic_wrapped_store_release_i32(target, value);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    cfish_Atomic_wrapped_store_release_i64(target, value);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    cfish_Atomic_wrapped_store_release_ptr(target, value);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    cfish_Atomic_wrapped_fence();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    cfish_Atomic_wrapped_fence();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    cfish_Atomic_wrapped_fence();
+}
+
 /**************************** Solaris 10 and later ************************/
 #elif defined(CHY_HAS_SYS_ATOMIC_H)
 #include <sys/atomic.h>
 
+/* Solaris barriers:
+ *
+ *   membar_enter:    StoreLoad  | StoreStore
+ *   membar_exit:     LoadStore  | StoreStore
+ *   membar_producer: StoreStore
+ *   membar_consumer: LoadLoad
+ */
+
 static CFISH_INLINE bool
 cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     return atomic_cas_ptr(target, old_value, new_value) == old_value;
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    return (int32_t)atomic_cas_32((volatile uint32_t*)target,
+                                  (uint32_t)old_value, (uint32_t)new_value)
+           == old_value;
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    return (int64_t)atomic_cas_64((volatile uint64_t*)target,
+                                  (uint64_t)old_value, (uint64_t)new_value)
+           == old_value;
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    return (size_t)atomic_inc_ulong_nv((volatile ulong_t*)target);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    // Publish prior writes before the count drops and keep the thread
+    // which reaches zero from touching the object too early.
+    membar_exit();
+    size_t retval = (size_t)atomic_dec_ulong_nv((volatile ulong_t*)target);
+    membar_enter();
+    membar_consumer();
+    return retval;
+}
+
+// atomic_add_*_nv return the new value.
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    cfish_Atomic_fence();
+    int32_t retval
+        = (int32_t)atomic_add_32_nv((volatile uint32_t*)target, value)
+          - value;
+    cfish_Atomic_fence();
+    return retval;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return cfish_Atomic_fetch_add_i32(target, -value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    cfish_Atomic_fence();
+    int64_t retval
+        = (int64_t)atomic_add_64_nv((volatile uint64_t*)target, value)
+          - value;
+    cfish_Atomic_fence();
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return cfish_Atomic_fetch_add_i64(target, -value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    int32_t retval = *target;
+    membar_consumer();
+    membar_exit();
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    // Plain 64-bit loads may tear on 32-bit CPUs.
+    int64_t retval = (int64_t)atomic_add_64_nv((volatile uint64_t*)target, 0);
+    membar_consumer();
+    membar_exit();
+    return retval;
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    void *retval = *target;
+    membar_consumer();
+    membar_exit();
+    return retval;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    membar_exit();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    membar_exit();
+    atomic_swap_64((volatile uint64_t*)target, (uint64_t)value);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    membar_exit();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    membar_consumer();
+    membar_exit();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    membar_exit();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    membar_consumer();
+    membar_exit();
+    membar_enter();
+}
+
 /****************************** GCC 4.1 and later *************************/
 #elif defined(CHY_HAS___SYNC_BOOL_COMPARE_AND_SWAP)
 
@@ -93,6 +759,103 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     return __sync_bool_compare_and_swap(target, old_value, new_value);
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    return __sync_bool_compare_and_swap(target, old_value, new_value);
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    return __sync_bool_compare_and_swap(target, old_value, new_value);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    return __sync_add_and_fetch(target, 1);
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    return __sync_sub_and_fetch(target, 1);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    return __sync_fetch_and_add(target, value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return __sync_fetch_and_sub(target, value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    return __sync_fetch_and_add(target, value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return __sync_fetch_and_sub(target, value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    int32_t retval = *target;
+    __sync_synchronize();
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    // Plain 64-bit loads may tear on 32-bit CPUs.
+    return __sync_fetch_and_add(target, 0);
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    void *retval = *target;
+    __sync_synchronize();
+    return retval;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    __sync_synchronize();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    int64_t old_value;
+    do {
+        old_value = *target;
+    } while (!__sync_bool_compare_and_swap(target, old_value, value));
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    __sync_synchronize();
+    *target = value;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    __sync_synchronize();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    __sync_synchronize();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    __sync_synchronize();
+}
+
 /************************ Fall back to pthread.h. **************************/
 #elif defined(CHY_HAS_PTHREAD_H)
 #include <pthread.h>
@@ -113,6 +876,133 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
     }
 }
 
+static CFISH_INLINE bool
+cfish_Atomic_cas_i32(int32_t volatile *target, int32_t old_value,
+                     int32_t new_value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    bool retval = *target == old_value;
+    if (retval) { *target = new_value; }
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE bool
+cfish_Atomic_cas_i64(int64_t volatile *target, int64_t old_value,
+                     int64_t new_value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    bool retval = *target == old_value;
+    if (retval) { *target = new_value; }
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_incr_size(size_t volatile *target) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    size_t retval = ++*target;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE size_t
+cfish_Atomic_decr_size(size_t volatile *target) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    size_t retval = --*target;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_add_i32(int32_t volatile *target, int32_t value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    int32_t retval = *target;
+    *target = retval + value;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_fetch_sub_i32(int32_t volatile *target, int32_t value) {
+    return cfish_Atomic_fetch_add_i32(target, -value);
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_add_i64(int64_t volatile *target, int64_t value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    int64_t retval = *target;
+    *target = retval + value;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_fetch_sub_i64(int64_t volatile *target, int64_t value) {
+    return cfish_Atomic_fetch_add_i64(target, -value);
+}
+
+static CFISH_INLINE int32_t
+cfish_Atomic_load_acquire_i32(int32_t volatile *target) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    int32_t retval = *target;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE int64_t
+cfish_Atomic_load_acquire_i64(int64_t volatile *target) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    int64_t retval = *target;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE void*
+cfish_Atomic_load_acquire_ptr(void *volatile *target) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    void *retval = *target;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+    return retval;
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i32(int32_t volatile *target, int32_t value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    *target = value;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_i64(int64_t volatile *target, int64_t value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    *target = value;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_store_release_ptr(void *volatile *target, void *value) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    *target = value;
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+}
+
+// Locking and unlocking a mutex acts as a full memory barrier.
+
+static CFISH_INLINE void
+cfish_Atomic_fence(void) {
+    pthread_mutex_lock(&cfish_Atomic_mutex);
+    pthread_mutex_unlock(&cfish_Atomic_mutex);
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_acquire(void) {
+    cfish_Atomic_fence();
+}
+
+static CFISH_INLINE void
+cfish_Atomic_fence_release(void) {
+    cfish_Atomic_fence();
+}
+
 /******************** No support for atomics at all. ***********************/
 #else
 
@@ -120,8 +1010,45 @@ cfish_Atomic_cas_ptr(void *volatile *target, void *old_value, void *new_value) {
 
 #endif /* Big platform if-else chain. */
 
+/* The pause hint depends on the CPU, not on the threading backend.
+ */
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+static CFISH_INLINE void
+cfish_Atomic_pause(void) {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __asm__ __volatile__("pause");
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#elif defined(__GNUC__) && (defined(__powerpc__) || defined(__ppc__))
+    __asm__ __volatile__("or 27,27,27");
+#endif
+}
+
 #ifdef CFISH_USE_SHORT_NAMES
   #define Atomic_cas_ptr cfish_Atomic_cas_ptr
+  #define Atomic_cas_i32 cfish_Atomic_cas_i32
+  #define Atomic_cas_i64 cfish_Atomic_cas_i64
+  #define Atomic_incr_size cfish_Atomic_incr_size
+  #define Atomic_decr_size cfish_Atomic_decr_size
+  #define Atomic_fetch_add_i32 cfish_Atomic_fetch_add_i32
+  #define Atomic_fetch_sub_i32 cfish_Atomic_fetch_sub_i32
+  #define Atomic_fetch_add_i64 cfish_Atomic_fetch_add_i64
+  #define Atomic_fetch_sub_i64 cfish_Atomic_fetch_sub_i64
+  #define Atomic_load_acquire_i32 cfish_Atomic_load_acquire_i32
+  #define Atomic_load_acquire_i64 cfish_Atomic_load_acquire_i64
+  #define Atomic_load_acquire_ptr cfish_Atomic_load_acquire_ptr
+  #define Atomic_store_release_i32 cfish_Atomic_store_release_i32
+  #define Atomic_store_release_i64 cfish_Atomic_store_release_i64
+  #define Atomic_store_release_ptr cfish_Atomic_store_release_ptr
+  #define Atomic_fence_acquire cfish_Atomic_fence_acquire
+  #define Atomic_fence_release cfish_Atomic_fence_release
+  #define Atomic_fence cfish_Atomic_fence
+  #define Atomic_pause cfish_Atomic_pause
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,82 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_FUTURE
+#define CFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Util/Future.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/ThreadPool.h"
+
+Future*
+Future_new(ThreadPool *pool, Err_Attempt_t routine, void *context) {
+    Future *self = (Future*)Class_Make_Obj(FUTURE);
+    return Future_init(self, pool, routine, context);
+}
+
+Future*
+Future_init(Future *self, ThreadPool *pool, Err_Attempt_t routine,
+            void *context) {
+    // The pool isn't INCREFed.  It outlives all of its tasks.
+    self->pool    = pool;
+    self->routine = routine;
+    self->context = context;
+    self->error   = NULL;
+    self->done    = 0;
+    return self;
+}
+
+void
+Future_Destroy_IMP(Future *self) {
+    if (!Future_Is_Done_IMP(self)) {
+        ThreadPool_Wait_For(self->pool, self);
+    }
+    DECREF(self->error);
+    SUPER_DESTROY(self, FUTURE);
+}
+
+void
+Future_Run_IMP(Future *self) {
+    self->error = Err_trap(self->routine, self->context);
+    // Last access.  Once `done` is set, the Future may be destroyed.
+    Atomic_store_release_i32(&self->done, 1);
+}
+
+bool
+Future_Is_Done_IMP(Future *self) {
+    return Atomic_load_acquire_i32(&self->done) != 0;
+}
+
+void
+Future_Join_IMP(Future *self) {
+    Err *error = Future_Get_Error_IMP(self);
+    if (error) {
+        // Several threads may join the same Future, so the shared Err is
+        // thrown as is rather than having a frame added via RETHROW.
+        Err_do_throw((Err*)INCREF(error));
+    }
+}
+
+Err*
+Future_Get_Error_IMP(Future *self) {
+    if (!Future_Is_Done_IMP(self)) {
+        ThreadPool_Wait_For(self->pool, self);
+    }
+    return self->error;
+}
+
@@ -0,0 +1,161 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_MPMCQUEUE
+#define CFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Util/MPMCQueue.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/Memory.h"
+
+#define CACHE_LINE_SIZE 64
+#define MAX_CAPACITY    ((size_t)1 << 30)
+
+/* Sequence numbers and positions are 32-bit counters which wrap around.
+ * Differences are computed with unsigned arithmetic and interpreted as
+ * signed, which is correct as long as the capacity is below 2^31.
+ */
+typedef struct {
+    int32_t  sequence;
+    Obj     *value;
+} Cell;
+
+/* Keep producer and consumer positions on separate cache lines. */
+typedef struct {
+    char     pad0[CACHE_LINE_SIZE];
+    int32_t  enqueue_pos;
+    char     pad1[CACHE_LINE_SIZE - sizeof(int32_t)];
+    int32_t  dequeue_pos;
+    char     pad2[CACHE_LINE_SIZE - sizeof(int32_t)];
+    Cell     cells[1];
+} QueueState;
+
+MPMCQueue*
+MPMCQueue_new(size_t capacity) {
+    MPMCQueue *self = (MPMCQueue*)Class_Make_Obj(MPMCQUEUE);
+    return MPMCQueue_init(self, capacity);
+}
+
+MPMCQueue*
+MPMCQueue_init(MPMCQueue *self, size_t capacity) {
+    if (capacity > MAX_CAPACITY) {
+        THROW(ERR, "MPMCQueue capacity too large: %u64",
+              (uint64_t)capacity);
+    }
+
+    // The algorithm needs at least two cells.
+    size_t rounded = 2;
+    while (rounded < capacity) { rounded <<= 1; }
+    self->capacity = rounded;
+
+    QueueState *state
+        = (QueueState*)CALLOCATE(1, sizeof(QueueState)
+                                    + (rounded - 1) * sizeof(Cell));
+    for (size_t i = 0; i < rounded; i++) {
+        state->cells[i].sequence = (int32_t)i;
+    }
+    self->state = state;
+
+    return self;
+}
+
+void
+MPMCQueue_Destroy_IMP(MPMCQueue *self) {
+    if (self->state) {
+        Obj *elem;
+        while (NULL != (elem = MPMCQueue_Pop_IMP(self))) {
+            DECREF(elem);
+        }
+        FREEMEM(self->state);
+    }
+    SUPER_DESTROY(self, MPMCQUEUE);
+}
+
+bool
+MPMCQueue_Push_IMP(MPMCQueue *self, Obj *elem) {
+    if (elem == NULL) {
+        THROW(ERR, "Can't push NULL onto MPMCQueue");
+    }
+
+    QueueState *state = (QueueState*)self->state;
+    uint32_t    mask  = (uint32_t)self->capacity - 1;
+    uint32_t    pos   = (uint32_t)Atomic_load_acquire_i32(&state->enqueue_pos);
+    Cell       *cell;
+
+    while (1) {
+        cell = &state->cells[pos & mask];
+        uint32_t seq  = (uint32_t)Atomic_load_acquire_i32(&cell->sequence);
+        int32_t  diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            // The cell is free.  Try to claim it.
+            if (Atomic_cas_i32(&state->enqueue_pos, (int32_t)pos,
+                               (int32_t)(pos + 1))) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell still holds an element from the previous lap.
+            return false;
+        }
+        pos = (uint32_t)Atomic_load_acquire_i32(&state->enqueue_pos);
+    }
+
+    cell->value = elem;
+    Atomic_store_release_i32(&cell->sequence, (int32_t)(pos + 1));
+    return true;
+}
+
+Obj*
+MPMCQueue_Pop_IMP(MPMCQueue *self) {
+    QueueState *state = (QueueState*)self->state;
+    uint32_t    mask  = (uint32_t)self->capacity - 1;
+    uint32_t    pos   = (uint32_t)Atomic_load_acquire_i32(&state->dequeue_pos);
+    Cell       *cell;
+
+    while (1) {
+        cell = &state->cells[pos & mask];
+        uint32_t seq  = (uint32_t)Atomic_load_acquire_i32(&cell->sequence);
+        int32_t  diff = (int32_t)(seq - (pos + 1));
+
+        if (diff == 0) {
+            // The cell holds an element.  Try to claim it.
+            if (Atomic_cas_i32(&state->dequeue_pos, (int32_t)pos,
+                               (int32_t)(pos + 1))) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The producer hasn't filled the cell yet.
+            return NULL;
+        }
+        pos = (uint32_t)Atomic_load_acquire_i32(&state->dequeue_pos);
+    }
+
+    Obj *elem = cell->value;
+    cell->value = NULL;
+    // Hand the cell to the producer of the next lap.
+    Atomic_store_release_i32(&cell->sequence, (int32_t)(pos + mask + 1));
+    return elem;
+}
+
+size_t
+MPMCQueue_Get_Capacity_IMP(MPMCQueue *self) {
+    return self->capacity;
+}
+
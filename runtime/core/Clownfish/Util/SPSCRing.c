@@ -0,0 +1,133 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_SPSCRING
+#define CFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Util/SPSCRing.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/Memory.h"
+
+#define CACHE_LINE_SIZE 64
+#define MAX_CAPACITY    ((size_t)1 << 30)
+
+/* `head` and `tail` are 32-bit counters which wrap around.  Each side
+ * keeps a cached copy of the other side's counter on its own cache line
+ * and only reloads it when the ring looks full or empty.
+ */
+typedef struct {
+    char     pad0[CACHE_LINE_SIZE];
+    // Written by the consumer.
+    int32_t  head;
+    char     pad1[CACHE_LINE_SIZE - sizeof(int32_t)];
+    // Written by the producer.
+    int32_t  tail;
+    char     pad2[CACHE_LINE_SIZE - sizeof(int32_t)];
+    // Owned by the consumer.
+    uint32_t cached_tail;
+    char     pad3[CACHE_LINE_SIZE - sizeof(uint32_t)];
+    // Owned by the producer.
+    uint32_t cached_head;
+    char     pad4[CACHE_LINE_SIZE - sizeof(uint32_t)];
+    Obj     *slots[1];
+} RingState;
+
+SPSCRing*
+SPSCRing_new(size_t capacity) {
+    SPSCRing *self = (SPSCRing*)Class_Make_Obj(SPSCRING);
+    return SPSCRing_init(self, capacity);
+}
+
+SPSCRing*
+SPSCRing_init(SPSCRing *self, size_t capacity) {
+    if (capacity > MAX_CAPACITY) {
+        THROW(ERR, "SPSCRing capacity too large: %u64",
+              (uint64_t)capacity);
+    }
+
+    size_t rounded = 1;
+    while (rounded < capacity) { rounded <<= 1; }
+    self->capacity = rounded;
+
+    self->state = CALLOCATE(1, sizeof(RingState)
+                               + (rounded - 1) * sizeof(Obj*));
+
+    return self;
+}
+
+void
+SPSCRing_Destroy_IMP(SPSCRing *self) {
+    if (self->state) {
+        Obj *elem;
+        while (NULL != (elem = SPSCRing_Pop_IMP(self))) {
+            DECREF(elem);
+        }
+        FREEMEM(self->state);
+    }
+    SUPER_DESTROY(self, SPSCRING);
+}
+
+bool
+SPSCRing_Push_IMP(SPSCRing *self, Obj *elem) {
+    if (elem == NULL) {
+        THROW(ERR, "Can't push NULL onto SPSCRing");
+    }
+
+    RingState *state    = (RingState*)self->state;
+    uint32_t   capacity = (uint32_t)self->capacity;
+    // Only the producer writes `tail`.
+    uint32_t   tail     = (uint32_t)state->tail;
+
+    if (tail - state->cached_head == capacity) {
+        state->cached_head = (uint32_t)Atomic_load_acquire_i32(&state->head);
+        if (tail - state->cached_head == capacity) {
+            return false;
+        }
+    }
+
+    state->slots[tail & (capacity - 1)] = elem;
+    Atomic_store_release_i32(&state->tail, (int32_t)(tail + 1));
+    return true;
+}
+
+Obj*
+SPSCRing_Pop_IMP(SPSCRing *self) {
+    RingState *state    = (RingState*)self->state;
+    uint32_t   capacity = (uint32_t)self->capacity;
+    // Only the consumer writes `head`.
+    uint32_t   head     = (uint32_t)state->head;
+
+    if (head == state->cached_tail) {
+        state->cached_tail = (uint32_t)Atomic_load_acquire_i32(&state->tail);
+        if (head == state->cached_tail) {
+            return NULL;
+        }
+    }
+
+    Obj **slot = &state->slots[head & (capacity - 1)];
+    Obj  *elem = *slot;
+    *slot = NULL;
+    Atomic_store_release_i32(&state->head, (int32_t)(head + 1));
+    return elem;
+}
+
+size_t
+SPSCRing_Get_Capacity_IMP(SPSCRing *self) {
+    return self->capacity;
+}
+
@@ -37,6 +37,19 @@ SI_merge(void *left_vptr,  size_t left_size,
          void *right_vptr, size_t right_size,
          void *vdest, size_t width, CFISH_Sort_Compare_t compare, void *context);
 
+// Heap and selection helpers.
+static CFISH_INLINE void
+SI_swap(uint8_t *a, uint8_t *b, size_t width);
+static void
+S_sift_down(uint8_t *elems, size_t root, size_t size, size_t width,
+            CFISH_Sort_Compare_t compare, void *context);
+static void
+S_heap_select(uint8_t *elems, size_t num_elems, size_t k, size_t width,
+              CFISH_Sort_Compare_t compare, void *context);
+static size_t
+S_partition(uint8_t *elems, size_t left, size_t right, size_t width,
+            CFISH_Sort_Compare_t compare, void *context);
+
 void
 Sort_mergesort(void *elems, void *scratch, size_t num_elems, size_t width,
                CFISH_Sort_Compare_t compare, void *context) {
@@ -61,6 +74,64 @@ Sort_mergesort(void *elems, void *scratch, size_t num_elems, size_t width,
     }
 }
 
+void
+Sort_partial_sort(void *velems, size_t num_elems, size_t k, size_t width,
+                  CFISH_Sort_Compare_t compare, void *context) {
+    uint8_t *elems = (uint8_t*)velems;
+    if (width == 0) {
+        THROW(ERR, "Parameter 'width' cannot be 0");
+    }
+    if (k > num_elems) { k = num_elems; }
+    if (k == 0) { return; }
+
+    // Gather the k smallest elements into a max-heap at the front, then
+    // heapsort them in place.
+    S_heap_select(elems, num_elems, k, width, compare, context);
+    for (size_t size = k - 1; size > 0; size--) {
+        SI_swap(elems, elems + size * width, width);
+        S_sift_down(elems, 0, size, width, compare, context);
+    }
+}
+
+void
+Sort_select_nth(void *velems, size_t num_elems, size_t nth, size_t width,
+                CFISH_Sort_Compare_t compare, void *context) {
+    uint8_t *elems = (uint8_t*)velems;
+    if (width == 0) {
+        THROW(ERR, "Parameter 'width' cannot be 0");
+    }
+    if (nth >= num_elems) { return; }
+
+    // Quickselect, limited to roughly 2 * log2(n) partitioning rounds.
+    // Pathological inputs fall back to heap selection, which bounds the
+    // worst case at O(n log n).
+    size_t budget = 0;
+    for (size_t n = num_elems; n > 1; n >>= 1) { budget += 2; }
+
+    size_t left  = 0;
+    size_t right = num_elems - 1;
+    while (right > left) {
+        if (budget == 0) {
+            Sort_partial_sort(elems + left * width, right - left + 1,
+                              nth - left + 1, width, compare, context);
+            return;
+        }
+        budget--;
+
+        size_t pivot = S_partition(elems, left, right, width, compare,
+                                   context);
+        if (pivot == nth) {
+            return;
+        }
+        else if (nth < pivot) {
+            right = pivot - 1;
+        }
+        else {
+            left = pivot + 1;
+        }
+    }
+}
+
 #define WIDTH 4
 static void
 S_msort4(void *velems, void *vscratch, size_t left, size_t right,
@@ -144,4 +215,90 @@ SI_merge(void *left_vptr,  size_t left_size,
     memcpy(dest, right_ptr, (size_t)right_remaining);
 }
 
+static CFISH_INLINE void
+SI_swap(uint8_t *a, uint8_t *b, size_t width) {
+    uint8_t tmp[64];
+    while (width > 0) {
+        size_t chunk = width < sizeof(tmp) ? width : sizeof(tmp);
+        memcpy(tmp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, tmp, chunk);
+        a     += chunk;
+        b     += chunk;
+        width -= chunk;
+    }
+}
+
+// Restore the max-heap property for the subtree at `root` in a heap of
+// `size` elements.
+static void
+S_sift_down(uint8_t *elems, size_t root, size_t size, size_t width,
+            CFISH_Sort_Compare_t compare, void *context) {
+    while (1) {
+        size_t child = 2 * root + 1;
+        if (child >= size) { break; }
+        if (child + 1 < size
+            && compare(context, elems + child * width,
+                       elems + (child + 1) * width) < 0
+           ) {
+            child++;
+        }
+        if (compare(context, elems + root * width,
+                    elems + child * width) >= 0
+           ) {
+            break;
+        }
+        SI_swap(elems + root * width, elems + child * width, width);
+        root = child;
+    }
+}
+
+// Move the k smallest elements to the front of the array, arranged as a
+// max-heap.  Assumes 0 < k <= num_elems.
+static void
+S_heap_select(uint8_t *elems, size_t num_elems, size_t k, size_t width,
+              CFISH_Sort_Compare_t compare, void *context) {
+    for (size_t i = k / 2; i-- > 0;) {
+        S_sift_down(elems, i, k, width, compare, context);
+    }
+    for (size_t i = k; i < num_elems; i++) {
+        uint8_t *candidate = elems + i * width;
+        if (compare(context, candidate, elems) < 0) {
+            SI_swap(elems, candidate, width);
+            S_sift_down(elems, 0, k, width, compare, context);
+        }
+    }
+}
+
+// Partition the range [left, right] around a median-of-three pivot and
+// return the pivot's final position.  Assumes left < right.
+static size_t
+S_partition(uint8_t *elems, size_t left, size_t right, size_t width,
+            CFISH_Sort_Compare_t compare, void *context) {
+    uint8_t *left_ptr  = elems + left * width;
+    uint8_t *mid_ptr   = elems + (left + (right - left) / 2) * width;
+    uint8_t *right_ptr = elems + right * width;
+
+    // Order the three candidates, then park the median at `right`.
+    if (compare(context, mid_ptr, left_ptr) < 0) {
+        SI_swap(mid_ptr, left_ptr, width);
+    }
+    if (compare(context, right_ptr, left_ptr) < 0) {
+        SI_swap(right_ptr, left_ptr, width);
+    }
+    if (compare(context, mid_ptr, right_ptr) < 0) {
+        SI_swap(mid_ptr, right_ptr, width);
+    }
+
+    size_t store = left;
+    for (size_t i = left; i < right; i++) {
+        uint8_t *ptr = elems + i * width;
+        if (compare(context, ptr, right_ptr) < 0) {
+            SI_swap(ptr, elems + store * width, width);
+            store++;
+        }
+    }
+    SI_swap(elems + store * width, right_ptr, width);
 
+    return store;
+}
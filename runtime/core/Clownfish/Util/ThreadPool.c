@@ -0,0 +1,502 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_THREADPOOL
+#define CFISH_USE_SHORT_NAMES
+
+#include "charmony.h"
+
+#include <string.h>
+
+#include "Clownfish/Util/ThreadPool.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/Future.h"
+#include "Clownfish/Util/HostRuntime.h"
+#include "Clownfish/Util/Memory.h"
+
+typedef struct Worker Worker;
+
+/********************************** Windows ********************************/
+#if !defined(CFISH_NOTHREADS) && defined(CHY_HAS_WINDOWS_H)
+
+#include <windows.h>
+
+#define HAS_THREADS 1
+
+static void
+S_worker_loop(Worker *worker);
+
+typedef CRITICAL_SECTION   Mutex;
+typedef CONDITION_VARIABLE Cond;
+typedef HANDLE             ThreadHandle;
+
+#define S_mutex_init(m)      InitializeCriticalSection(m)
+#define S_mutex_destroy(m)   DeleteCriticalSection(m)
+#define S_mutex_lock(m)      EnterCriticalSection(m)
+#define S_mutex_unlock(m)    LeaveCriticalSection(m)
+#define S_cond_init(c)       InitializeConditionVariable(c)
+#define S_cond_destroy(c)
+#define S_cond_wait(c, m)    SleepConditionVariableCS(c, m, INFINITE)
+#define S_cond_signal(c)     WakeConditionVariable(c)
+#define S_cond_broadcast(c)  WakeAllConditionVariable(c)
+
+static DWORD __stdcall
+S_thread_main(void *arg) {
+    S_worker_loop((Worker*)arg);
+    return 0;
+}
+
+static void
+S_thread_start(ThreadHandle *handle, Worker *worker) {
+    *handle = CreateThread(NULL, 0, S_thread_main, worker, 0, NULL);
+    if (*handle == NULL) {
+        THROW(ERR, "CreateThread failed: %s", Err_win_error());
+    }
+}
+
+static void
+S_thread_join(ThreadHandle *handle) {
+    WaitForSingleObject(*handle, INFINITE);
+    CloseHandle(*handle);
+}
+
+uint32_t
+ThreadPool_num_cpus() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0
+           ? (uint32_t)info.dwNumberOfProcessors
+           : 1;
+}
+
+/******************************** pthreads *********************************/
+#elif !defined(CFISH_NOTHREADS) && defined(CHY_HAS_PTHREAD_H)
+
+#include <pthread.h>
+#ifdef CHY_HAS_UNISTD_H
+  #include <unistd.h>
+#endif
+
+#define HAS_THREADS 1
+
+static void
+S_worker_loop(Worker *worker);
+
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t  Cond;
+typedef pthread_t       ThreadHandle;
+
+#define S_mutex_init(m)      pthread_mutex_init(m, NULL)
+#define S_mutex_destroy(m)   pthread_mutex_destroy(m)
+#define S_mutex_lock(m)      pthread_mutex_lock(m)
+#define S_mutex_unlock(m)    pthread_mutex_unlock(m)
+#define S_cond_init(c)       pthread_cond_init(c, NULL)
+#define S_cond_destroy(c)    pthread_cond_destroy(c)
+#define S_cond_wait(c, m)    pthread_cond_wait(c, m)
+#define S_cond_signal(c)     pthread_cond_signal(c)
+#define S_cond_broadcast(c)  pthread_cond_broadcast(c)
+
+static void*
+S_thread_main(void *arg) {
+    S_worker_loop((Worker*)arg);
+    return NULL;
+}
+
+static void
+S_thread_start(ThreadHandle *handle, Worker *worker) {
+    int err = pthread_create(handle, NULL, S_thread_main, worker);
+    if (err != 0) {
+        THROW(ERR, "pthread_create failed: %s", strerror(err));
+    }
+}
+
+static void
+S_thread_join(ThreadHandle *handle) {
+    pthread_join(*handle, NULL);
+}
+
+uint32_t
+ThreadPool_num_cpus() {
+#if defined(CHY_HAS_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return num_cpus > 0 ? (uint32_t)num_cpus : 1;
+#else
+    return 1;
+#endif
+}
+
+/**************************** No thread support ****************************/
+#else
+
+#define HAS_THREADS 0
+
+typedef int Mutex;
+typedef int Cond;
+typedef int ThreadHandle;
+
+#define S_mutex_init(m)      UNUSED_VAR(m)
+#define S_mutex_destroy(m)   UNUSED_VAR(m)
+#define S_mutex_lock(m)      UNUSED_VAR(m)
+#define S_mutex_unlock(m)    UNUSED_VAR(m)
+#define S_cond_init(c)       UNUSED_VAR(c)
+#define S_cond_destroy(c)    UNUSED_VAR(c)
+#define S_cond_wait(c, m)    UNUSED_VAR(c)
+#define S_cond_signal(c)     UNUSED_VAR(c)
+#define S_cond_broadcast(c)  UNUSED_VAR(c)
+
+static void
+S_thread_start(ThreadHandle *handle, Worker *worker) {
+    UNUSED_VAR(handle);
+    UNUSED_VAR(worker);
+    THROW(ERR, "No thread support");
+}
+
+static void
+S_thread_join(ThreadHandle *handle) {
+    UNUSED_VAR(handle);
+}
+
+uint32_t
+ThreadPool_num_cpus() {
+    return 1;
+}
+
+#endif /* Platform switch. */
+
+/***************************************************************************/
+
+/* Double-ended task queue.  The owning worker pushes and pops at the back,
+ * thieves take tasks from the front.
+ */
+typedef struct {
+    Mutex    lock;
+    Future **tasks;
+    size_t   cap;
+    size_t   head;
+    size_t   size;
+} Deque;
+
+typedef struct PoolState PoolState;
+
+struct Worker {
+    PoolState    *state;
+    uint32_t      index;
+    void         *host_runtime;
+    ThreadHandle  handle;
+};
+
+struct PoolState {
+    Mutex     lock;
+    Cond      work_cond;   // New task queued or shutdown.
+    Cond      done_cond;   // Task finished.
+    int32_t   num_queued;
+    int32_t   next_deque;
+    bool      shutdown;
+    uint32_t  num_deques;
+    Deque    *deques;
+    uint32_t  num_workers;
+    Worker   *workers;
+};
+
+static void
+S_deque_push_back(Deque *deque, Future *task) {
+    S_mutex_lock(&deque->lock);
+    if (deque->size == deque->cap) {
+        size_t   new_cap   = deque->cap ? deque->cap * 2 : 16;
+        Future **new_tasks = (Future**)MALLOCATE(new_cap * sizeof(Future*));
+        for (size_t i = 0; i < deque->size; i++) {
+            new_tasks[i] = deque->tasks[(deque->head + i) % deque->cap];
+        }
+        FREEMEM(deque->tasks);
+        deque->tasks = new_tasks;
+        deque->cap   = new_cap;
+        deque->head  = 0;
+    }
+    deque->tasks[(deque->head + deque->size) % deque->cap] = task;
+    deque->size++;
+    S_mutex_unlock(&deque->lock);
+}
+
+static Future*
+S_deque_pop(Deque *deque, bool from_back) {
+    Future *task = NULL;
+    S_mutex_lock(&deque->lock);
+    if (deque->size > 0) {
+        deque->size--;
+        if (from_back) {
+            task = deque->tasks[(deque->head + deque->size) % deque->cap];
+        }
+        else {
+            task = deque->tasks[deque->head];
+            deque->head = (deque->head + 1) % deque->cap;
+        }
+    }
+    S_mutex_unlock(&deque->lock);
+    return task;
+}
+
+/* Take a task from the deque at `index`, or steal one from another deque.
+ */
+static Future*
+S_take_task(PoolState *state, uint32_t index) {
+    if (Atomic_load_acquire_i32(&state->num_queued) == 0) {
+        return NULL;
+    }
+
+    uint32_t num_deques = state->num_deques;
+    for (uint32_t i = 0; i < num_deques; i++) {
+        Deque  *deque = &state->deques[(index + i) % num_deques];
+        Future *task  = S_deque_pop(deque, i == 0);
+        if (task) {
+            Atomic_fetch_sub_i32(&state->num_queued, 1);
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+static void
+S_run_task(PoolState *state, Future *task) {
+    Future_Run(task);
+    // Wake up threads waiting for a Future.
+    S_mutex_lock(&state->lock);
+    S_cond_broadcast(&state->done_cond);
+    S_mutex_unlock(&state->lock);
+}
+
+#if HAS_THREADS
+static void
+S_worker_loop(Worker *worker) {
+    PoolState *state = worker->state;
+
+    if (worker->host_runtime) {
+        HostRuntime_set_current(worker->host_runtime);
+    }
+
+    while (1) {
+        Future *task = S_take_task(state, worker->index);
+        if (task) {
+            S_run_task(state, task);
+            continue;
+        }
+
+        S_mutex_lock(&state->lock);
+        while (Atomic_load_acquire_i32(&state->num_queued) == 0
+               && !state->shutdown
+              ) {
+            S_cond_wait(&state->work_cond, &state->lock);
+        }
+        bool finished = state->shutdown
+                        && Atomic_load_acquire_i32(&state->num_queued) == 0;
+        S_mutex_unlock(&state->lock);
+
+        if (finished) { break; }
+    }
+}
+#endif /* HAS_THREADS */
+
+ThreadPool*
+ThreadPool_new(uint32_t num_threads) {
+    ThreadPool *self = (ThreadPool*)Class_Make_Obj(THREADPOOL);
+    return ThreadPool_init(self, num_threads);
+}
+
+ThreadPool*
+ThreadPool_init(ThreadPool *self, uint32_t num_threads) {
+    if (!HAS_THREADS) {
+        num_threads = 0;
+    }
+
+    PoolState *state = (PoolState*)CALLOCATE(1, sizeof(PoolState));
+    S_mutex_init(&state->lock);
+    S_cond_init(&state->work_cond);
+    S_cond_init(&state->done_cond);
+
+    // A pool without workers still needs a deque for its waiters to run.
+    state->num_deques = num_threads ? num_threads : 1;
+    state->deques
+        = (Deque*)CALLOCATE(state->num_deques, sizeof(Deque));
+    for (uint32_t i = 0; i < state->num_deques; i++) {
+        S_mutex_init(&state->deques[i].lock);
+    }
+
+    state->workers = num_threads
+                     ? (Worker*)CALLOCATE(num_threads, sizeof(Worker))
+                     : NULL;
+    self->state       = state;
+    self->num_threads = num_threads;
+
+    for (uint32_t i = 0; i < num_threads; i++) {
+        Worker *worker = &state->workers[i];
+        worker->state        = state;
+        worker->index        = i;
+        worker->host_runtime = HostRuntime_clone();
+        S_thread_start(&worker->handle, worker);
+        state->num_workers++;
+    }
+
+    return self;
+}
+
+void
+ThreadPool_Destroy_IMP(ThreadPool *self) {
+    PoolState *state = (PoolState*)self->state;
+
+    if (state) {
+        // Workers finish all queued tasks before they exit.
+        S_mutex_lock(&state->lock);
+        state->shutdown = true;
+        S_cond_broadcast(&state->work_cond);
+        S_mutex_unlock(&state->lock);
+
+        for (uint32_t i = 0; i < state->num_workers; i++) {
+            Worker *worker = &state->workers[i];
+            S_thread_join(&worker->handle);
+            if (worker->host_runtime) {
+                HostRuntime_destroy(worker->host_runtime);
+            }
+        }
+
+        // Without workers, run leftover tasks here.
+        Future *task;
+        while (NULL != (task = S_take_task(state, 0))) {
+            S_run_task(state, task);
+        }
+
+        for (uint32_t i = 0; i < state->num_deques; i++) {
+            S_mutex_destroy(&state->deques[i].lock);
+            FREEMEM(state->deques[i].tasks);
+        }
+        FREEMEM(state->deques);
+        FREEMEM(state->workers);
+        S_cond_destroy(&state->done_cond);
+        S_cond_destroy(&state->work_cond);
+        S_mutex_destroy(&state->lock);
+        FREEMEM(state);
+    }
+
+    SUPER_DESTROY(self, THREADPOOL);
+}
+
+Future*
+ThreadPool_Submit_IMP(ThreadPool *self, Err_Attempt_t routine,
+                      void *context) {
+    PoolState *state  = (PoolState*)self->state;
+    Future    *future = Future_new(self, routine, context);
+
+    uint32_t index = (uint32_t)Atomic_fetch_add_i32(&state->next_deque, 1)
+                     % state->num_deques;
+    S_deque_push_back(&state->deques[index], future);
+    Atomic_fetch_add_i32(&state->num_queued, 1);
+
+    S_mutex_lock(&state->lock);
+    S_cond_signal(&state->work_cond);
+    S_mutex_unlock(&state->lock);
+
+    return future;
+}
+
+void
+ThreadPool_Wait_For_IMP(ThreadPool *self, Future *future) {
+    PoolState *state = (PoolState*)self->state;
+    uint32_t   index = 0;
+
+    while (!Future_Is_Done(future)) {
+        // Help out instead of blocking.
+        Future *task = S_take_task(state, index++);
+        if (task) {
+            S_run_task(state, task);
+            continue;
+        }
+
+        // The task is running in another thread.
+        S_mutex_lock(&state->lock);
+        while (!Future_Is_Done(future)
+               && Atomic_load_acquire_i32(&state->num_queued) == 0
+              ) {
+            S_cond_wait(&state->done_cond, &state->lock);
+        }
+        S_mutex_unlock(&state->lock);
+    }
+}
+
+typedef struct {
+    Parallel_For_t  func;
+    void           *context;
+    size_t          begin;
+    size_t          end;
+} Chunk;
+
+static void
+S_run_chunk(void *vchunk) {
+    Chunk *chunk = (Chunk*)vchunk;
+    chunk->func(chunk->context, chunk->begin, chunk->end);
+}
+
+void
+ThreadPool_Parallel_For_IMP(ThreadPool *self, size_t size, size_t grain,
+                            Parallel_For_t func, void *context) {
+    if (size == 0) { return; }
+    if (grain == 0) { grain = 1; }
+
+    size_t num_chunks = (size - 1) / grain + 1;
+    if (num_chunks == 1 || self->num_threads == 0) {
+        func(context, 0, size);
+        return;
+    }
+
+    Chunk   *chunks  = (Chunk*)MALLOCATE(num_chunks * sizeof(Chunk));
+    Future **futures = (Future**)MALLOCATE(num_chunks * sizeof(Future*));
+    for (size_t i = 0; i < num_chunks; i++) {
+        Chunk *chunk = &chunks[i];
+        chunk->func    = func;
+        chunk->context = context;
+        chunk->begin   = i * grain;
+        chunk->end     = size - chunk->begin > grain
+                         ? chunk->begin + grain
+                         : size;
+    }
+
+    // The calling thread takes the first chunk and helps with the rest
+    // while it waits.
+    for (size_t i = 1; i < num_chunks; i++) {
+        futures[i] = ThreadPool_Submit_IMP(self, S_run_chunk, &chunks[i]);
+    }
+    Err *error = Err_trap(S_run_chunk, &chunks[0]);
+    for (size_t i = 1; i < num_chunks; i++) {
+        Err *chunk_error = Future_Get_Error(futures[i]);
+        if (chunk_error && !error) {
+            error = (Err*)INCREF(chunk_error);
+        }
+        DECREF(futures[i]);
+    }
+
+    FREEMEM(futures);
+    FREEMEM(chunks);
+
+    if (error) {
+        RETHROW(error);
+    }
+}
+
+uint32_t
+ThreadPool_Get_Num_Threads_IMP(ThreadPool *self) {
+    return self->num_threads;
+}
+
@@ -0,0 +1,167 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_CFISH_TOPK
+#define C_CFISH_VECTOR
+#define CFISH_USE_SHORT_NAMES
+
+#include <string.h>
+
+#include "Clownfish/Util/TopK.h"
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Vector.h"
+#include "Clownfish/Util/Memory.h"
+
+static void
+S_sift_up(TopK *self, size_t tick);
+
+static void
+S_sift_down(TopK *self, size_t root, size_t size);
+
+TopK*
+TopK_new(size_t k, CFISH_Sort_Compare_t compare, void *context) {
+    TopK *self = (TopK*)Class_Make_Obj(TOPK);
+    return TopK_init(self, k, compare, context);
+}
+
+TopK*
+TopK_init(TopK *self, size_t k, CFISH_Sort_Compare_t compare,
+          void *context) {
+    if (compare == NULL) {
+        THROW(ERR, "Comparison function is required");
+    }
+    if (k > SIZE_MAX / sizeof(Obj*)) {
+        THROW(ERR, "TopK size overflow: %u64", (uint64_t)k);
+    }
+
+    // Init.
+    self->size = 0;
+
+    // Assign.
+    self->k       = k;
+    self->compare = compare;
+    self->context = context;
+
+    // Derive.
+    self->elems = (Obj**)CALLOCATE(k ? k : 1, sizeof(Obj*));
+
+    return self;
+}
+
+void
+TopK_Destroy_IMP(TopK *self) {
+    for (size_t i = 0; i < self->size; i++) {
+        DECREF(self->elems[i]);
+    }
+    FREEMEM(self->elems);
+    SUPER_DESTROY(self, TOPK);
+}
+
+bool
+TopK_Insert_IMP(TopK *self, Obj *elem) {
+    if (self->size < self->k) {
+        self->elems[self->size] = elem;
+        S_sift_up(self, self->size);
+        self->size++;
+        return true;
+    }
+    else if (self->size > 0
+             && self->compare(self->context, &elem, self->elems) < 0
+            ) {
+        // Displace the lowest-ranked element at the top of the heap.
+        DECREF(self->elems[0]);
+        self->elems[0] = elem;
+        S_sift_down(self, 0, self->size);
+        return true;
+    }
+    else {
+        DECREF(elem);
+        return false;
+    }
+}
+
+Obj*
+TopK_Peek_IMP(TopK *self) {
+    return self->size ? self->elems[0] : NULL;
+}
+
+Vector*
+TopK_Pop_All_IMP(TopK *self) {
+    // Heapsort in place: repeatedly move the top of the max-heap to the end.
+    for (size_t size = self->size; size > 1; size--) {
+        Obj *top = self->elems[0];
+        self->elems[0] = self->elems[size - 1];
+        self->elems[size - 1] = top;
+        S_sift_down(self, 0, size - 1);
+    }
+
+    // Transfer ownership of the elements to the Vector.
+    Vector *retval = Vec_new(self->size);
+    memcpy(retval->elems, self->elems, self->size * sizeof(Obj*));
+    retval->size = self->size;
+    self->size = 0;
+
+    return retval;
+}
+
+size_t
+TopK_Get_Size_IMP(TopK *self) {
+    return self->size;
+}
+
+size_t
+TopK_Get_K_IMP(TopK *self) {
+    return self->k;
+}
+
+static void
+S_sift_up(TopK *self, size_t tick) {
+    Obj **elems = self->elems;
+    Obj  *elem  = elems[tick];
+    while (tick > 0) {
+        size_t parent = (tick - 1) / 2;
+        if (self->compare(self->context, &elem, &elems[parent]) <= 0) {
+            break;
+        }
+        elems[tick] = elems[parent];
+        tick = parent;
+    }
+    elems[tick] = elem;
+}
+
+static void
+S_sift_down(TopK *self, size_t root, size_t size) {
+    Obj **elems = self->elems;
+    Obj  *elem  = elems[root];
+    while (1) {
+        size_t child = 2 * root + 1;
+        if (child >= size) { break; }
+        if (child + 1 < size
+            && self->compare(self->context, &elems[child],
+                             &elems[child + 1]) < 0
+           ) {
+            child++;
+        }
+        if (self->compare(self->context, &elem, &elems[child]) >= 0) {
+            break;
+        }
+        elems[root] = elems[child];
+        root = child;
+    }
+    elems[root] = elem;
+}
+
@@ -22,7 +22,10 @@
 
 #include "Clownfish/Class.h"
 #include "Clownfish/Vector.h"
+#include "Clownfish/Blob.h"
 #include "Clownfish/Err.h"
+#include "Clownfish/Num.h"
+#include "Clownfish/String.h"
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Util/SortUtils.h"
 
@@ -244,12 +247,208 @@ S_default_compare(void *context, const void *va, const void *vb) {
 
 void
 Vec_Sort_IMP(Vector *self) {
+    Vec_Sort_With(self, S_default_compare, NULL);
+}
+
+void
+Vec_Sort_With_IMP(Vector *self, CFISH_Sort_Compare_t compare,
+                  void *context) {
     void *scratch = MALLOCATE(self->size * sizeof(Obj*));
     Sort_mergesort(self->elems, scratch, self->size, sizeof(void*),
-                   S_default_compare, NULL);
+                   compare, context);
     FREEMEM(scratch);
 }
 
+// A decorated element for Sort_By_Key.  The key is cached in the
+// representation which allows for the cheapest comparison.
+typedef struct {
+    union {
+        int64_t i64;
+        double  f64;
+        struct {
+            const char *ptr;
+            size_t      size;
+        } bytes;
+    } key;
+    Obj *key_obj;
+    Obj *elem;
+} SortEntry;
+
+static int
+S_compare_byte_keys(void *context, const void *va, const void *vb) {
+    const SortEntry *a = (const SortEntry*)va;
+    const SortEntry *b = (const SortEntry*)vb;
+    size_t min_size = a->key.bytes.size < b->key.bytes.size
+                      ? a->key.bytes.size
+                      : b->key.bytes.size;
+    UNUSED_VAR(context);
+    int comparison = memcmp(a->key.bytes.ptr, b->key.bytes.ptr, min_size);
+    if (comparison != 0) { return comparison; }
+    return a->key.bytes.size < b->key.bytes.size ? -1
+           : a->key.bytes.size > b->key.bytes.size ? 1
+           : 0;
+}
+
+static int
+S_compare_i64_keys(void *context, const void *va, const void *vb) {
+    int64_t a = ((const SortEntry*)va)->key.i64;
+    int64_t b = ((const SortEntry*)vb)->key.i64;
+    UNUSED_VAR(context);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+static int
+S_compare_f64_keys(void *context, const void *va, const void *vb) {
+    double a = ((const SortEntry*)va)->key.f64;
+    double b = ((const SortEntry*)vb)->key.f64;
+    UNUSED_VAR(context);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+static int
+S_compare_obj_keys(void *context, const void *va, const void *vb) {
+    const SortEntry *a = (const SortEntry*)va;
+    const SortEntry *b = (const SortEntry*)vb;
+    UNUSED_VAR(context);
+    return Obj_Compare_To(a->key_obj, b->key_obj);
+}
+
+typedef struct {
+    Vector         *vector;
+    Vec_Sort_Key_t  key_func;
+    void           *key_context;
+    SortEntry      *entries;
+    SortEntry      *scratch;
+    size_t          num_keyed;
+    size_t          num_unkeyed;
+} SortByKeyContext;
+
+// Decorate and sort.  Runs inside Err_trap, so that the keys can be released
+// if `key_func` or a key comparison throws.
+static void
+S_sort_entries(void *vcontext) {
+    SortByKeyContext *sort_context = (SortByKeyContext*)vcontext;
+    Vector         *self      = sort_context->vector;
+    Vec_Sort_Key_t  key_func  = sort_context->key_func;
+    void           *context   = sort_context->key_context;
+    SortEntry      *entries   = sort_context->entries;
+    const size_t    size      = self->size;
+    Class          *key_class = NULL;
+
+    // Decorate.  Keyed entries are collected at the front of the array,
+    // unkeyed elements at the back in reverse order.
+    for (size_t i = 0; i < size; i++) {
+        Obj *elem = self->elems[i];
+        Obj *key  = elem ? key_func(context, elem) : NULL;
+        if (key) {
+            size_t num_keyed = sort_context->num_keyed;
+            Class *klass = Obj_get_class(key);
+            if (num_keyed == 0)         { key_class = klass; }
+            else if (klass != key_class) { key_class = NULL; }
+            entries[num_keyed].key_obj = key;
+            entries[num_keyed].elem    = elem;
+            sort_context->num_keyed = num_keyed + 1;
+        }
+        else {
+            sort_context->num_unkeyed++;
+            entries[size - sort_context->num_unkeyed].elem = elem;
+        }
+    }
+    const size_t num_keyed = sort_context->num_keyed;
+
+    // Cache keys and pick a comparison function.
+    CFISH_Sort_Compare_t compare = S_compare_obj_keys;
+    if (key_class == STRING) {
+        for (size_t i = 0; i < num_keyed; i++) {
+            String *key = (String*)entries[i].key_obj;
+            entries[i].key.bytes.ptr  = Str_Get_Ptr8(key);
+            entries[i].key.bytes.size = Str_Get_Size(key);
+        }
+        compare = S_compare_byte_keys;
+    }
+    else if (key_class == BLOB) {
+        for (size_t i = 0; i < num_keyed; i++) {
+            Blob *key = (Blob*)entries[i].key_obj;
+            entries[i].key.bytes.ptr  = Blob_Get_Buf(key);
+            entries[i].key.bytes.size = Blob_Get_Size(key);
+        }
+        compare = S_compare_byte_keys;
+    }
+    else if (key_class == INTEGER) {
+        for (size_t i = 0; i < num_keyed; i++) {
+            entries[i].key.i64 = Int_Get_Value((Integer*)entries[i].key_obj);
+        }
+        compare = S_compare_i64_keys;
+    }
+    else if (key_class == FLOAT) {
+        for (size_t i = 0; i < num_keyed; i++) {
+            entries[i].key.f64 = Float_Get_Value((Float*)entries[i].key_obj);
+        }
+        compare = S_compare_f64_keys;
+    }
+
+    // Sort.
+    sort_context->scratch
+        = (SortEntry*)MALLOCATE(num_keyed * sizeof(SortEntry));
+    Sort_mergesort(entries, sort_context->scratch, num_keyed,
+                   sizeof(SortEntry), compare, NULL);
+}
+
+void
+Vec_Sort_By_Key_IMP(Vector *self, Vec_Sort_Key_t key_func, void *context) {
+    const size_t size = self->size;
+    SortByKeyContext sort_context;
+    sort_context.vector      = self;
+    sort_context.key_func    = key_func;
+    sort_context.key_context = context;
+    sort_context.entries     = (SortEntry*)MALLOCATE(size * sizeof(SortEntry));
+    sort_context.scratch     = NULL;
+    sort_context.num_keyed   = 0;
+    sort_context.num_unkeyed = 0;
+
+    Err *error = Err_trap(S_sort_entries, &sort_context);
+
+    SortEntry    *entries     = sort_context.entries;
+    const size_t  num_keyed   = sort_context.num_keyed;
+    const size_t  num_unkeyed = sort_context.num_unkeyed;
+    FREEMEM(sort_context.scratch);
+
+    if (error) {
+        // Leave the Vector untouched and release the keys computed so far.
+        for (size_t i = 0; i < num_keyed; i++) {
+            DECREF(entries[i].key_obj);
+        }
+        FREEMEM(entries);
+        RETHROW(error);
+    }
+
+    // Undecorate.
+    for (size_t i = 0; i < num_keyed; i++) {
+        self->elems[i] = entries[i].elem;
+        DECREF(entries[i].key_obj);
+    }
+    for (size_t i = 0; i < num_unkeyed; i++) {
+        self->elems[num_keyed + i] = entries[size - 1 - i].elem;
+    }
+    FREEMEM(entries);
+}
+
+void
+Vec_Partial_Sort_IMP(Vector *self, size_t k) {
+    Sort_partial_sort(self->elems, self->size, k, sizeof(void*),
+                      S_default_compare, NULL);
+}
+
+Obj*
+Vec_Select_Nth_IMP(Vector *self, size_t nth) {
+    if (nth >= self->size) {
+        return NULL;
+    }
+    Sort_select_nth(self->elems, self->size, nth, sizeof(void*),
+                    S_default_compare, NULL);
+    return self->elems[nth];
+}
+
 bool
 Vec_Equals_IMP(Vector *self, Obj *other) {
     Vector *twin = (Vector*)other;
@@ -279,6 +478,14 @@ Vec_Equals_IMP(Vector *self, Obj *other) {
     return true;
 }
 
+void
+Vec_Share_IMP(Vector *self) {
+    if (!Obj_make_shared((Obj*)self)) { return; }
+    for (size_t i = 0; i < self->size; i++) {
+        if (self->elems[i]) { Obj_Share(self->elems[i]); }
+    }
+}
+
 Vector*
 Vec_Slice_IMP(Vector *self, size_t offset, size_t length) {
     // Adjust ranges if necessary.
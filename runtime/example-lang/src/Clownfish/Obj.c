@@ -42,4 +42,10 @@ CFISH_Obj_To_Host_IMP(cfish_Obj *self, void *vcache) {
     UNREACHABLE_RETURN(void*);
 }
 
+bool
+cfish_Obj_make_shared(cfish_Obj *self) {
+    THROW(CFISH_ERR, "TODO");
+    UNREACHABLE_RETURN(bool);
+}
+
 
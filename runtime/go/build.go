@@ -168,6 +168,18 @@ func specMethods(parcel *cfc.Parcel) {
 	blobBinding.SpecMethod("", "GetBuf() uintptr")
 	blobBinding.Register()
 
+	i32ArrBinding := cfc.NewGoClass(parcel, "Clownfish::I32Array")
+	i32ArrBinding.SpecMethod("", "Int32s() []int32")
+	i32ArrBinding.Register()
+
+	i64ArrBinding := cfc.NewGoClass(parcel, "Clownfish::I64Array")
+	i64ArrBinding.SpecMethod("", "Int64s() []int64")
+	i64ArrBinding.Register()
+
+	f64ArrBinding := cfc.NewGoClass(parcel, "Clownfish::F64Array")
+	f64ArrBinding.SpecMethod("", "Float64s() []float64")
+	f64ArrBinding.Register()
+
 	vecBinding := cfc.NewGoClass(parcel, "Clownfish::Vector")
 	vecBinding.SetSuppressCtor(true)
 	vecBinding.Register()
@@ -19,6 +19,7 @@ package clownfish
 /*
 
 #include <limits.h>
+#include <string.h>
 
 #include "charmony.h"
 
@@ -34,6 +35,7 @@ package clownfish
 #include "Clownfish/HashIterator.h"
 #include "Clownfish/Vector.h"
 #include "Clownfish/Num.h"
+#include "Clownfish/NumArray.h"
 #include "Clownfish/Boolean.h"
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Method.h"
@@ -65,6 +67,154 @@ GoCfish_RunRoutine(CFISH_Err_Attempt_t routine, void *context) {
 	routine(context);
 }
 
+// Accessors for the index of a class's WRAP function, defined in
+// ext/clownfish.c.
+extern size_t
+GoCfish_Obj_wrap_index(cfish_Obj *obj);
+extern void
+GoCfish_Class_set_wrap_index(cfish_Class *klass, size_t index);
+extern size_t
+GoCfish_Class_get_wrap_index(cfish_Class *klass);
+
+// Vectors and Hashes are converted in batches to avoid a cgo call per
+// element.  Each element is described by a type code, a 64-bit value and a
+// pointer-sized value:
+//
+//   STRING:  value = size, ptr = UTF-8 data (export) or offset into a byte
+//            buffer (import)
+//   INTEGER: value = integer
+//   FLOAT:   value = bits of the double
+//   OBJ:     ptr = object, borrowed (export) or incremented (import)
+#define GOCFISH_CONV_NULL    0
+#define GOCFISH_CONV_STRING  1
+#define GOCFISH_CONV_INTEGER 2
+#define GOCFISH_CONV_FLOAT   3
+#define GOCFISH_CONV_TRUE    4
+#define GOCFISH_CONV_FALSE   5
+#define GOCFISH_CONV_OBJ     6
+
+static CHY_INLINE void
+GoCfish_export_elem(cfish_Obj *obj, uint8_t *type, int64_t *value,
+                    uintptr_t *ptr) {
+	if (obj == NULL) {
+		*type = GOCFISH_CONV_NULL;
+		return;
+	}
+	cfish_Class *klass = cfish_Obj_get_class(obj);
+	if (klass == CFISH_STRING) {
+		*type  = GOCFISH_CONV_STRING;
+		*value = (int64_t)CFISH_Str_Get_Size((cfish_String*)obj);
+		*ptr   = (uintptr_t)CFISH_Str_Get_Ptr8((cfish_String*)obj);
+	}
+	else if (klass == CFISH_INTEGER) {
+		*type  = GOCFISH_CONV_INTEGER;
+		*value = CFISH_Int_Get_Value((cfish_Integer*)obj);
+	}
+	else if (klass == CFISH_FLOAT) {
+		double f64 = CFISH_Float_Get_Value((cfish_Float*)obj);
+		*type = GOCFISH_CONV_FLOAT;
+		memcpy(value, &f64, sizeof(f64));
+	}
+	else if (obj == (cfish_Obj*)CFISH_TRUE) {
+		*type = GOCFISH_CONV_TRUE;
+	}
+	else if (obj == (cfish_Obj*)CFISH_FALSE) {
+		*type = GOCFISH_CONV_FALSE;
+	}
+	else {
+		*type = GOCFISH_CONV_OBJ;
+		*ptr  = (uintptr_t)obj;
+	}
+}
+
+static CHY_INLINE cfish_Obj*
+GoCfish_import_elem(uint8_t type, int64_t value, uintptr_t ptr,
+                    const char *bytes) {
+	switch (type) {
+		case GOCFISH_CONV_NULL:
+			return NULL;
+		case GOCFISH_CONV_STRING:
+			return (cfish_Obj*)cfish_Str_new_from_utf8(bytes + ptr,
+			                                           (size_t)value);
+		case GOCFISH_CONV_INTEGER:
+			return (cfish_Obj*)cfish_Int_new(value);
+		case GOCFISH_CONV_FLOAT: {
+			double f64;
+			memcpy(&f64, &value, sizeof(f64));
+			return (cfish_Obj*)cfish_Float_new(f64);
+		}
+		case GOCFISH_CONV_TRUE:
+			return (cfish_Obj*)cfish_inc_refcount(CFISH_TRUE);
+		case GOCFISH_CONV_FALSE:
+			return (cfish_Obj*)cfish_inc_refcount(CFISH_FALSE);
+		default:
+			return (cfish_Obj*)ptr;
+	}
+}
+
+// Export up to `count` elements of `vec` starting at `offset`.  Return the
+// number of elements exported.
+static CHY_INLINE size_t
+GoCfish_Vec_export(cfish_Vector *vec, size_t offset, size_t count,
+                   uint8_t *types, int64_t *values, uintptr_t *ptrs) {
+	size_t size = CFISH_Vec_Get_Size(vec);
+	if (offset >= size) {
+		return 0;
+	}
+	if (count > size - offset) {
+		count = size - offset;
+	}
+	for (size_t i = 0; i < count; i++) {
+		cfish_Obj *elem = CFISH_Vec_Fetch(vec, offset + i);
+		GoCfish_export_elem(elem, &types[i], &values[i], &ptrs[i]);
+	}
+	return count;
+}
+
+// Export up to `count` entries of the Hash being iterated over.  Return the
+// number of entries exported.
+static CHY_INLINE size_t
+GoCfish_HashIter_export(cfish_HashIterator *iter, size_t count,
+                        uint8_t *types, int64_t *values, uintptr_t *ptrs,
+                        uintptr_t *key_ptrs, size_t *key_sizes) {
+	size_t i = 0;
+	while (i < count && CFISH_HashIter_Next(iter)) {
+		cfish_String *key = CFISH_HashIter_Get_Key(iter);
+		cfish_Obj *value = CFISH_HashIter_Get_Value(iter);
+		key_ptrs[i]  = (uintptr_t)CFISH_Str_Get_Ptr8(key);
+		key_sizes[i] = CFISH_Str_Get_Size(key);
+		GoCfish_export_elem(value, &types[i], &values[i], &ptrs[i]);
+		i++;
+	}
+	return i;
+}
+
+static CHY_INLINE void
+GoCfish_Vec_import(cfish_Vector *vec, size_t offset, size_t count,
+                   const uint8_t *types, const int64_t *values,
+                   const uintptr_t *ptrs, const char *bytes) {
+	for (size_t i = 0; i < count; i++) {
+		cfish_Obj *elem
+			= GoCfish_import_elem(types[i], values[i], ptrs[i], bytes);
+		CFISH_Vec_Store(vec, offset + i, elem);
+	}
+}
+
+static CHY_INLINE void
+GoCfish_Hash_import(cfish_Hash *hash, size_t count, const uint8_t *types,
+                    const int64_t *values, const uintptr_t *ptrs,
+                    const uintptr_t *key_offsets, const size_t *key_sizes,
+                    const char *bytes) {
+	for (size_t i = 0; i < count; i++) {
+		cfish_String *key
+			= cfish_Str_new_from_utf8(bytes + key_offsets[i], key_sizes[i]);
+		cfish_Obj *value
+			= GoCfish_import_elem(types[i], values[i], ptrs[i], bytes);
+		CFISH_Hash_Store(hash, key, value);
+		cfish_dec_refcount(key);
+	}
+}
+
 */
 import "C"
 import "runtime"
@@ -73,6 +223,8 @@ import "reflect"
 import "fmt"
 import "math"
 import "sync"
+import "sync/atomic"
+import "unicode/utf8"
 
 const (
 	maxUint = ^uint(0)
@@ -82,8 +234,12 @@ const (
 )
 
 type WrapFunc func(unsafe.Pointer)Obj
+
+// WRAP functions are stored in a copy-on-write slice which is indexed by the
+// wrap index stored in each Class.  Writers serialize on wrapRegMutex;
+// readers only need an atomic load.
 var wrapRegMutex sync.Mutex
-var wrapReg *map[unsafe.Pointer]WrapFunc
+var wrapFuncs atomic.Value // []WrapFunc
 
 func init() {
 	C.GoCfish_glue_exported_symbols()
@@ -94,34 +250,40 @@ func init() {
 
 func RegisterWrapFuncs(newEntries map[unsafe.Pointer]WrapFunc) {
 	wrapRegMutex.Lock()
-	newSize := len(newEntries)
-	if wrapReg != nil {
-		newSize += len(*wrapReg)
-	}
-	newReg := make(map[unsafe.Pointer]WrapFunc, newSize)
-	if wrapReg != nil {
-		for k, v := range *wrapReg {
-			newReg[k] = v
+	defer wrapRegMutex.Unlock()
+	oldFuncs, _ := wrapFuncs.Load().([]WrapFunc)
+	funcs := make([]WrapFunc, len(oldFuncs), len(oldFuncs)+len(newEntries))
+	copy(funcs, oldFuncs)
+	newClasses := make(map[*C.cfish_Class]int, len(newEntries))
+	for k, v := range newEntries {
+		class := (*C.cfish_Class)(k)
+		index := int(C.GoCfish_Class_get_wrap_index(class))
+		if index > 0 && index <= len(funcs) {
+			funcs[index-1] = v
+		} else {
+			funcs = append(funcs, v)
+			newClasses[class] = len(funcs)
 		}
 	}
-	for k, v := range newEntries {
-		newReg[k] = v
+	// Publish the functions before the indices which refer to them.
+	wrapFuncs.Store(funcs)
+	for class, index := range newClasses {
+		C.GoCfish_Class_set_wrap_index(class, C.size_t(index))
 	}
-	wrapReg = &newReg
-	wrapRegMutex.Unlock()
 }
 
 func WRAPAny(ptr unsafe.Pointer) Obj {
 	if ptr == nil {
 		return nil
 	}
-	class := C.cfish_Obj_get_class((*C.cfish_Obj)(ptr))
-	wrapFunc := (*wrapReg)[unsafe.Pointer(class)]
-	if wrapFunc == nil {
+	index := int(C.GoCfish_Obj_wrap_index((*C.cfish_Obj)(ptr)))
+	funcs, _ := wrapFuncs.Load().([]WrapFunc)
+	if index == 0 || index > len(funcs) {
+		class := C.cfish_Obj_get_class((*C.cfish_Obj)(ptr))
 		className := CFStringToGo(unsafe.Pointer(C.CFISH_Class_Get_Name((*C.cfish_Class)(class))))
 		panic(fmt.Sprintf("Failed to find WRAP function for %s", className))
 	}
-	return wrapFunc(ptr)
+	return funcs[index-1](ptr)
 }
 
 type ObjIMP struct {
@@ -174,6 +336,18 @@ func NewString(goString string) String {
 	return WRAPString(unsafe.Pointer(cfObj))
 }
 
+// BorrowStringData returns a pointer to the bytes of `goString` for
+// generated method glue, which passes it to C along with the length.  A C
+// shim wraps the bytes in a stack String and invokes the method within the
+// same cgo call, so they stay in place without pinning or copying.  Panics
+// if `goString` isn't valid UTF-8.
+func BorrowStringData(goString string) unsafe.Pointer {
+	if !utf8.ValidString(goString) {
+		panic(NewErr("Invalid UTF-8"))
+	}
+	return unsafe.Pointer(unsafe.StringData(goString))
+}
+
 func NewStringIterator(str String, offset uintptr) StringIterator {
 	strCF := (*C.cfish_String)(Unwrap(str, "str"))
 	iter := C.cfish_StrIter_new(strCF, C.size_t(offset))
@@ -437,6 +611,132 @@ func goToBoolean(value interface{}, nullable bool) unsafe.Pointer {
 	panic(NewErr(mess))
 }
 
+// Maximum number of elements converted per cgo call.
+const convBatchSize = 1024
+
+// convBatch holds the elements of a Vector or Hash in the flat format
+// expected by the GoCfish_*_export and GoCfish_*_import functions.
+type convBatch struct {
+	count    int
+	types    []C.uint8_t
+	values   []C.int64_t
+	ptrs     []C.uintptr_t
+	keyPtrs  []C.uintptr_t
+	keySizes []C.size_t
+	bytes    []byte
+}
+
+func newConvBatch(size int, withKeys bool) *convBatch {
+	if size > convBatchSize {
+		size = convBatchSize
+	}
+	// Avoid empty slices, so that the address of the first element can
+	// always be taken.
+	if size == 0 {
+		size = 1
+	}
+	b := &convBatch{
+		types:  make([]C.uint8_t, size),
+		values: make([]C.int64_t, size),
+		ptrs:   make([]C.uintptr_t, size),
+	}
+	if withKeys {
+		b.keyPtrs = make([]C.uintptr_t, size)
+		b.keySizes = make([]C.size_t, size)
+	}
+	return b
+}
+
+func (b *convBatch) reset() {
+	b.count = 0
+	b.bytes = b.bytes[:0]
+}
+
+func (b *convBatch) bytesPtr() *C.char {
+	if len(b.bytes) == 0 {
+		return nil
+	}
+	return (*C.char)(unsafe.Pointer(&b.bytes[0]))
+}
+
+// Queue a Hash key for import.  Keys are stored in the byte buffer, like
+// strings.
+func (b *convBatch) pushKey(key string) {
+	b.keyPtrs[b.count] = C.uintptr_t(len(b.bytes))
+	b.keySizes[b.count] = C.size_t(len(key))
+	b.bytes = append(b.bytes, key...)
+}
+
+// Queue an element for import.  Strings and numbers are encoded in the
+// batch; everything else is converted to an incremented Clownfish object
+// right away.
+func (b *convBatch) push(value interface{}) {
+	i := b.count
+	switch v := value.(type) {
+	case nil:
+		b.types[i] = C.GOCFISH_CONV_NULL
+	case string:
+		b.types[i] = C.GOCFISH_CONV_STRING
+		b.values[i] = C.int64_t(len(v))
+		b.ptrs[i] = C.uintptr_t(len(b.bytes))
+		b.bytes = append(b.bytes, v...)
+	case int:
+		b.types[i] = C.GOCFISH_CONV_INTEGER
+		b.values[i] = C.int64_t(v)
+	case int64:
+		b.types[i] = C.GOCFISH_CONV_INTEGER
+		b.values[i] = C.int64_t(v)
+	case int32:
+		b.types[i] = C.GOCFISH_CONV_INTEGER
+		b.values[i] = C.int64_t(v)
+	case float64:
+		b.types[i] = C.GOCFISH_CONV_FLOAT
+		b.values[i] = C.int64_t(math.Float64bits(v))
+	case bool:
+		if v {
+			b.types[i] = C.GOCFISH_CONV_TRUE
+		} else {
+			b.types[i] = C.GOCFISH_CONV_FALSE
+		}
+	default:
+		b.types[i] = C.GOCFISH_CONV_OBJ
+		b.ptrs[i] = C.uintptr_t(uintptr(GoToClownfish(value, nil, true)))
+	}
+	b.count++
+}
+
+// Convert an exported element to Go.
+func (b *convBatch) toGo(i int) interface{} {
+	switch b.types[i] {
+	case C.GOCFISH_CONV_STRING:
+		return exportedStringToGo(b.ptrs[i], int(b.values[i]))
+	case C.GOCFISH_CONV_INTEGER:
+		return int64(b.values[i])
+	case C.GOCFISH_CONV_FLOAT:
+		return math.Float64frombits(uint64(b.values[i]))
+	case C.GOCFISH_CONV_TRUE:
+		return true
+	case C.GOCFISH_CONV_FALSE:
+		return false
+	case C.GOCFISH_CONV_OBJ:
+		return ToGo(unsafe.Pointer(uintptr(b.ptrs[i])))
+	}
+	return nil
+}
+
+// Return an exported Hash key.
+func (b *convBatch) key(i int) string {
+	return exportedStringToGo(b.keyPtrs[i], int(b.keySizes[i]))
+}
+
+// Copy exported string data into a Go string.
+func exportedStringToGo(ptr C.uintptr_t, size int) string {
+	if size == 0 {
+		return ""
+	}
+	return string(unsafe.Slice((*byte)(unsafe.Pointer(uintptr(ptr))), size))
+}
+
 func goToVector(value interface{}, nullable bool) unsafe.Pointer {
 	switch v := value.(type) {
 	case []interface{}:
@@ -447,9 +747,19 @@ func goToVector(value interface{}, nullable bool) unsafe.Pointer {
 		} else {
 			size := len(v)
 			vec := C.cfish_Vec_new(C.size_t(size))
-			for i := 0; i < size; i++ {
-				elem := GoToClownfish(v[i], nil, true)
-				C.CFISH_Vec_Store(vec, C.size_t(i), (*C.cfish_Obj)(elem))
+			batch := newConvBatch(size, false)
+			for offset := 0; offset < size; offset += convBatchSize {
+				batch.reset()
+				end := offset + convBatchSize
+				if end > size {
+					end = size
+				}
+				for _, elem := range v[offset:end] {
+					batch.push(elem)
+				}
+				C.GoCfish_Vec_import(vec, C.size_t(offset), C.size_t(batch.count),
+					&batch.types[0], &batch.values[0], &batch.ptrs[0],
+					batch.bytesPtr())
 			}
 			return unsafe.Pointer(vec)
 		}
@@ -471,13 +781,22 @@ func goToHash(value interface{}, nullable bool) unsafe.Pointer {
 		} else {
 			size := len(v)
 			hash := C.cfish_Hash_new(C.size_t(size))
+			batch := newConvBatch(size, true)
+			flush := func() {
+				C.GoCfish_Hash_import(hash, C.size_t(batch.count),
+					&batch.types[0], &batch.values[0], &batch.ptrs[0],
+					&batch.keyPtrs[0], &batch.keySizes[0], batch.bytesPtr())
+				batch.reset()
+			}
 			for key, val := range v {
-				newVal := GoToClownfish(val, nil, true)
-				keySize := len(key)
-				keyStr := C.CString(key)
-				cfKey := C.cfish_Str_new_steal_utf8(keyStr, C.size_t(keySize))
-				defer C.cfish_dec_refcount(unsafe.Pointer(cfKey))
-				C.CFISH_Hash_Store(hash, cfKey, (*C.cfish_Obj)(newVal))
+				batch.pushKey(key)
+				batch.push(val)
+				if batch.count == convBatchSize {
+					flush()
+				}
+			}
+			if batch.count > 0 {
+				flush()
 			}
 			return unsafe.Pointer(hash)
 		}
@@ -541,6 +860,29 @@ func StringToGo(ptr unsafe.Pointer) string {
 	return C.GoStringN(data, C.int(size))
 }
 
+// StringToGoUnsafe returns a Go string which aliases the buffer of a
+// Clownfish String without copying.  The result is only valid as long as the
+// caller holds a reference to the String.
+func StringToGoUnsafe(ptr unsafe.Pointer) string {
+	cfString := (*C.cfish_String)(ptr)
+	if cfString == nil {
+		return ""
+	}
+	if !C.cfish_Str_is_a(cfString, C.CFISH_STRING) {
+		// Conversion yields a temporary, so it has to be copied.
+		return StringToGo(ptr)
+	}
+	size := C.CFISH_Str_Get_Size(cfString)
+	if size == 0 {
+		return ""
+	}
+	if size > C.size_t(maxInt) {
+		panic(fmt.Sprintf("Overflow: %d > %d", size, maxInt))
+	}
+	data := C.CFISH_Str_Get_Ptr8(cfString)
+	return unsafe.String((*byte)(unsafe.Pointer(data)), int(size))
+}
+
 func BlobToGo(ptr unsafe.Pointer) []byte {
 	blob := (*C.cfish_Blob)(ptr)
 	if blob == nil {
@@ -574,8 +916,17 @@ func VectorToGo(ptr unsafe.Pointer) []interface{} {
 		panic(fmt.Sprintf("Overflow: %d > %d", size, maxInt))
 	}
 	slice := make([]interface{}, int(size))
-	for i := 0; i < int(size); i++ {
-		slice[i] = ToGo(unsafe.Pointer(C.CFISH_Vec_Fetch(vec, C.size_t(i))))
+	batch := newConvBatch(int(size), false)
+	for offset := 0; offset < int(size); offset += batch.count {
+		batch.count = int(C.GoCfish_Vec_export(vec, C.size_t(offset),
+			C.size_t(len(batch.types)), &batch.types[0], &batch.values[0],
+			&batch.ptrs[0]))
+		if batch.count == 0 {
+			break
+		}
+		for i := 0; i < batch.count; i++ {
+			slice[offset+i] = batch.toGo(i)
+		}
 	}
 	return slice
 }
@@ -594,10 +945,17 @@ func HashToGo(ptr unsafe.Pointer) map[string]interface{} {
 	m := make(map[string]interface{}, int(size))
 	iter := C.cfish_HashIter_new(hash)
 	defer C.cfish_dec_refcount(unsafe.Pointer(iter))
-	for C.CFISH_HashIter_Next(iter) {
-		key := C.CFISH_HashIter_Get_Key(iter)
-		val := C.CFISH_HashIter_Get_Value(iter)
-		m[StringToGo(unsafe.Pointer(key))] = ToGo(unsafe.Pointer(val))
+	batch := newConvBatch(int(size), true)
+	for {
+		batch.count = int(C.GoCfish_HashIter_export(iter,
+			C.size_t(len(batch.types)), &batch.types[0], &batch.values[0],
+			&batch.ptrs[0], &batch.keyPtrs[0], &batch.keySizes[0]))
+		if batch.count == 0 {
+			break
+		}
+		for i := 0; i < batch.count; i++ {
+			m[batch.key(i)] = batch.toGo(i)
+		}
 	}
 	return m
 }
@@ -677,3 +1035,39 @@ func (b *BlobIMP) GetBuf() uintptr {
 	self := (*C.cfish_Blob)(Unwrap(b, "b"))
 	return uintptr(unsafe.Pointer(C.CFISH_Blob_Get_Buf(self)))
 }
+
+// Int32s returns a slice which aliases the array's C buffer without copying.
+// The slice is only valid while the array is referenced and doesn't grow.
+// Since the array may be destroyed as soon as the last Go reference is gone,
+// callers must keep it alive, e.g. with runtime.KeepAlive, for as long as
+// they use the slice.
+func (a *I32ArrayIMP) Int32s() []int32 {
+	self := (*C.cfish_I32Array)(Unwrap(a, "a"))
+	size := int(C.CFISH_I32Arr_Get_Size(self))
+	if size == 0 {
+		return nil
+	}
+	return unsafe.Slice((*int32)(unsafe.Pointer(C.CFISH_I32Arr_Get_Ptr(self))), size)
+}
+
+// Int64s returns a slice which aliases the array's C buffer without copying.
+// The same restrictions as for I32Array.Int32s apply.
+func (a *I64ArrayIMP) Int64s() []int64 {
+	self := (*C.cfish_I64Array)(Unwrap(a, "a"))
+	size := int(C.CFISH_I64Arr_Get_Size(self))
+	if size == 0 {
+		return nil
+	}
+	return unsafe.Slice((*int64)(unsafe.Pointer(C.CFISH_I64Arr_Get_Ptr(self))), size)
+}
+
+// Float64s returns a slice which aliases the array's C buffer without
+// copying.  The same restrictions as for I32Array.Int32s apply.
+func (a *F64ArrayIMP) Float64s() []float64 {
+	self := (*C.cfish_F64Array)(Unwrap(a, "a"))
+	size := int(C.CFISH_F64Arr_Get_Size(self))
+	if size == 0 {
+		return nil
+	}
+	return unsafe.Slice((*float64)(unsafe.Pointer(C.CFISH_F64Arr_Get_Ptr(self))), size)
+}
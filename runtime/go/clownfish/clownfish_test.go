@@ -17,6 +17,8 @@
 package clownfish
 
 import "testing"
+import "runtime"
+import "fmt"
 import "unsafe"
 import "reflect"
 import "math"
@@ -35,6 +37,71 @@ func TestStringToGo(t *testing.T) {
 	}
 }
 
+func TestStringToGoUnsafe(t *testing.T) {
+	strings := []string{"foo", "", "z\u0000z"}
+	for _, val := range strings {
+		str := NewString(val)
+		got := StringToGoUnsafe(unsafe.Pointer(str.TOPTR()))
+		deepCheck(t, got, val)
+		runtime.KeepAlive(str)
+	}
+}
+
+func TestBorrowedStringArgs(t *testing.T) {
+	// String literals aren't allocated on the Go heap.
+	hash := NewHash(0)
+	hash.Store("foo", "bar")
+	hash.Store("", "empty")
+	if got := hash.Fetch("foo"); got != "bar" {
+		t.Errorf("Expected 'bar', got %v", got)
+	}
+	if got := hash.Fetch(""); got != "empty" {
+		t.Errorf("Expected 'empty', got %v", got)
+	}
+	// The stored keys must be copies.
+	keys := hash.Keys()
+	if len(keys) != 2 {
+		t.Errorf("Expected 2 keys, got %d", len(keys))
+	}
+
+	str := NewString("foobar")
+	if !str.StartsWith("foo") || str.StartsWith("bar") {
+		t.Error("StartsWith with borrowed string")
+	}
+
+	defer func() {
+		if recover() == nil {
+			t.Error("Invalid UTF-8 should panic")
+		}
+	}()
+	hash.Fetch("\xff")
+}
+
+func TestNumArraySlices(t *testing.T) {
+	i32s := NewI32Array(0)
+	i64s := NewI64Array(0)
+	f64s := NewF64Array(0)
+	for i := 0; i < 3; i++ {
+		i32s.Push(int32(i))
+		i64s.Push(int64(i) << 40)
+		f64s.Push(float64(i) / 2)
+	}
+	deepCheck(t, i32s.Int32s(), []int32{0, 1, 2})
+	deepCheck(t, i64s.Int64s(), []int64{0, 1 << 40, 2 << 40})
+	deepCheck(t, f64s.Float64s(), []float64{0, 0.5, 1})
+
+	// Writes through the slice are visible to Clownfish.
+	i32s.Int32s()[1] = 7
+	if got := i32s.Fetch(1); got != 7 {
+		t.Errorf("Expected 7 after write through slice, got %d", got)
+	}
+	runtime.KeepAlive(i32s)
+
+	if got := NewI32Array(0).Int32s(); got != nil {
+		t.Errorf("Expected nil slice for empty array, got %v", got)
+	}
+}
+
 func TestBlobToGo(t *testing.T) {
 	strings := []string{"foo", "", "z\u0000z"}
 	for _, str := range strings {
@@ -252,3 +319,120 @@ func TestGoToVector(t *testing.T) {
 	}
 	deepCheck(t, ToGo(unsafe.Pointer(got.TOPTR())), expected)
 }
+
+func TestWRAPAnyClass(t *testing.T) {
+	hashClass := FetchClass("Clownfish::Hash")
+	got := WRAPAny(unsafe.Pointer(hashClass.TOPTR()))
+	if _, ok := got.(Class); !ok {
+		t.Errorf("Not a Class, but a %T", got)
+	}
+}
+
+// Class objects are immortal, so they can be wrapped repeatedly without
+// touching refcounts.
+func BenchmarkWRAPAny(b *testing.B) {
+	ptr := unsafe.Pointer(FetchClass("Clownfish::Hash").TOPTR())
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		WRAPAny(ptr)
+	}
+}
+
+func BenchmarkWRAPAnyParallel(b *testing.B) {
+	ptr := unsafe.Pointer(FetchClass("Clownfish::Hash").TOPTR())
+	b.ResetTimer()
+	b.RunParallel(func(pb *testing.PB) {
+		for pb.Next() {
+			WRAPAny(ptr)
+		}
+	})
+}
+
+func TestVectorToGoBatches(t *testing.T) {
+	expected := make([]interface{}, 3000)
+	for i := range expected {
+		switch i % 5 {
+		case 0:
+			expected[i] = fmt.Sprintf("str%d", i)
+		case 1:
+			expected[i] = int64(i)
+		case 2:
+			expected[i] = float64(i) / 2
+		case 3:
+			expected[i] = i%2 == 0
+		case 4:
+			expected[i] = []interface{}{"nested", int64(i)}
+		}
+	}
+	expected[7] = nil
+	got := WRAPAny(goToVector(expected, false))
+	deepCheck(t, ToGo(unsafe.Pointer(got.TOPTR())), expected)
+}
+
+func TestHashToGoBatches(t *testing.T) {
+	expected := make(map[string]interface{}, 3000)
+	for i := 0; i < 3000; i++ {
+		expected[fmt.Sprintf("key%d", i)] = fmt.Sprintf("val%d", i)
+	}
+	expected[""] = int64(-1)
+	got := WRAPAny(goToHash(expected, false))
+	deepCheck(t, ToGo(unsafe.Pointer(got.TOPTR())), expected)
+}
+
+const benchContainerSize = 1000000
+
+func benchVector() []interface{} {
+	slice := make([]interface{}, benchContainerSize)
+	for i := range slice {
+		if i%2 == 0 {
+			slice[i] = fmt.Sprintf("element %d", i)
+		} else {
+			slice[i] = int64(i)
+		}
+	}
+	return slice
+}
+
+func benchHash() map[string]interface{} {
+	m := make(map[string]interface{}, benchContainerSize)
+	for i := 0; i < benchContainerSize; i++ {
+		m[fmt.Sprintf("key %d", i)] = int64(i)
+	}
+	return m
+}
+
+func BenchmarkGoToVector(b *testing.B) {
+	slice := benchVector()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		WRAPAny(goToVector(slice, false))
+	}
+}
+
+func BenchmarkVectorToGo(b *testing.B) {
+	vec := WRAPAny(goToVector(benchVector(), false))
+	ptr := unsafe.Pointer(vec.TOPTR())
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		VectorToGo(ptr)
+	}
+	runtime.KeepAlive(vec)
+}
+
+func BenchmarkGoToHash(b *testing.B) {
+	m := benchHash()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		WRAPAny(goToHash(m, false))
+	}
+}
+
+func BenchmarkHashToGo(b *testing.B) {
+	hash := WRAPAny(goToHash(benchHash(), false))
+	ptr := unsafe.Pointer(hash.TOPTR())
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		HashToGo(ptr)
+	}
+	runtime.KeepAlive(hash)
+}
@@ -16,6 +16,7 @@
 
 #define CFISH_USE_SHORT_NAMES
 #define C_CFISH_OBJ
+#define C_CFISH_STRING
 #define C_CFISH_CLASS
 #define C_CFISH_METHOD
 #define C_CFISH_ERR
@@ -37,6 +38,8 @@
 #include "Clownfish/Num.h"
 #include "Clownfish/Obj.h"
 #include "Clownfish/String.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/HostRuntime.h"
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Vector.h"
 
@@ -47,68 +50,96 @@ Err* (*GoCfish_TrapErr)(Err_Attempt_t routine, void *context);
 
 /******************************** Obj **************************************/
 
-static CFISH_INLINE bool
-SI_immortal(cfish_Class *klass) {
+/* Flags in the top bits of the refcount.  Objects without any of them take
+ * the fast path in INCREF and DECREF, which only touches the refcount
+ * itself and not the object's Class.
+ *
+ * SHARED_FLAG:   Object shared between threads, updated atomically.
+ * IMMORTAL_FLAG: Class, Method and Boolean singletons, never freed.
+ * STRING_FLAG:   String which must be copied on INCREF if it wraps an
+ *                external buffer.
+ */
+#define SHARED_FLAG   ((size_t)1 << (sizeof(size_t) * 8 - 1))
+#define IMMORTAL_FLAG ((size_t)1 << (sizeof(size_t) * 8 - 2))
+#define STRING_FLAG   ((size_t)1 << (sizeof(size_t) * 8 - 3))
+#define FLAGS_MASK    (SHARED_FLAG | IMMORTAL_FLAG | STRING_FLAG)
+
+static CFISH_INLINE size_t
+SI_refcount_flags(cfish_Class *klass) {
+    if (klass == CFISH_STRING) {
+        return STRING_FLAG;
+    }
     if (klass == CFISH_CLASS
         || klass == CFISH_METHOD
         || klass == CFISH_BOOLEAN
        ){
-        return true;
+        return IMMORTAL_FLAG;
     }
-    return false;
-}
-
-static CFISH_INLINE bool
-SI_is_string_type(cfish_Class *klass) {
-    if (klass == CFISH_STRING) {
-        return true;
-    }
-    return false;
+    return 0;
 }
 
 uint32_t
 cfish_get_refcount(void *vself) {
     cfish_Obj *self = (cfish_Obj*)vself;
-    return self->refcount;
+    return (uint32_t)(self->refcount & ~FLAGS_MASK);
 }
 
 Obj*
 cfish_inc_refcount(void *vself) {
     Obj *self = (Obj*)vself;
+    size_t refcount = self->refcount;
+
+    if (!(refcount & FLAGS_MASK)) {
+        self->refcount = refcount + 1;
+        return self;
+    }
 
     // Handle special cases.
-    cfish_Class *const klass = self->klass;
-    if (klass->flags & CFISH_fREFCOUNTSPECIAL) {
-        if (SI_is_string_type(klass)) {
-            // Only copy-on-incref Strings get special-cased.  Ordinary
-            // strings fall through to the general case.
-            if (CFISH_Str_Is_Copy_On_IncRef((cfish_String*)self)) {
-                const char *utf8 = CFISH_Str_Get_Ptr8((cfish_String*)self);
-                size_t size = CFISH_Str_Get_Size((cfish_String*)self);
-                return (cfish_Obj*)cfish_Str_new_from_trusted_utf8(utf8, size);
-            }
-        }
-        else if (SI_immortal(klass)) {
-            return self;
+    if (refcount & IMMORTAL_FLAG) {
+        return self;
+    }
+    if (refcount & STRING_FLAG) {
+        // Only copy-on-incref Strings get special-cased.  Ordinary
+        // strings fall through to the general case.
+        cfish_String *string = (cfish_String*)self;
+        if (string->origin == NULL) {
+            return (Obj*)Str_new_from_trusted_utf8(string->ptr, string->size);
         }
     }
 
-    self->refcount++;
+    if (refcount & SHARED_FLAG) {
+        Atomic_incr_size(&self->refcount);
+    }
+    else {
+        self->refcount = refcount + 1;
+    }
     return self;
 }
 
 uint32_t
 cfish_dec_refcount(void *vself) {
     cfish_Obj *self = (Obj*)vself;
-    cfish_Class *klass = self->klass;
-    if (klass->flags & CFISH_fREFCOUNTSPECIAL) {
-        if (SI_immortal(klass)) {
-            return self->refcount;
+    size_t refcount = self->refcount;
+
+    if (refcount & IMMORTAL_FLAG) {
+        return (uint32_t)(refcount & ~FLAGS_MASK);
+    }
+
+    if (refcount & SHARED_FLAG) {
+        size_t modified_refcount = Atomic_decr_size(&self->refcount);
+        if ((modified_refcount & FLAGS_MASK) != (refcount & FLAGS_MASK)) {
+            // Borrowed from the flags.
+            THROW(ERR, "Illegal refcount of 0");
+        }
+        modified_refcount &= ~FLAGS_MASK;
+        if (modified_refcount == 0) {
+            Obj_Destroy(self);
         }
+        return (uint32_t)modified_refcount;
     }
 
-    uint32_t modified_refcount = INT32_MAX;
-    switch (self->refcount) {
+    size_t modified_refcount = refcount & ~FLAGS_MASK;
+    switch (modified_refcount) {
         case 0:
             THROW(ERR, "Illegal refcount of 0");
             break; // useless
@@ -117,10 +148,20 @@ cfish_dec_refcount(void *vself) {
             Obj_Destroy(self);
             break;
         default:
-            modified_refcount = --self->refcount;
+            modified_refcount--;
+            self->refcount = refcount - 1;
             break;
     }
-    return modified_refcount;
+    return (uint32_t)modified_refcount;
+}
+
+bool
+Obj_make_shared(Obj *self) {
+    if (self->refcount & (IMMORTAL_FLAG | SHARED_FLAG)) {
+        return false;
+    }
+    self->refcount |= SHARED_FLAG;
+    return true;
 }
 
 void*
@@ -137,7 +178,7 @@ Obj*
 Class_Make_Obj_IMP(Class *self) {
     Obj *obj = (Obj*)Memory_wrapped_calloc(self->obj_alloc_size, 1);
     obj->klass = self;
-    obj->refcount = 1;
+    obj->refcount = 1 | SI_refcount_flags(self);
     return obj;
 }
 
@@ -146,7 +187,7 @@ Class_Init_Obj_IMP(Class *self, void *allocation) {
     memset(allocation, 0, self->obj_alloc_size);
     Obj *obj = (Obj*)allocation;
     obj->klass = self;
-    obj->refcount = 1;
+    obj->refcount = 1 | SI_refcount_flags(self);
     return obj;
 }
 
@@ -174,6 +215,26 @@ Class_adjust_host_subclass(Class *klass) {
     UNUSED_VAR(klass);
 }
 
+/* The Go bindings don't use the `host_type` slot of Class for anything
+ * else, so it stores the index of the class's WRAP function plus one.
+ */
+size_t
+GoCfish_Obj_wrap_index(Obj *obj) {
+    Class *klass = obj->klass;
+    return (size_t)(uintptr_t)Atomic_load_acquire_ptr(&klass->host_type);
+}
+
+size_t
+GoCfish_Class_get_wrap_index(Class *klass) {
+    return (size_t)(uintptr_t)Atomic_load_acquire_ptr(&klass->host_type);
+}
+
+void
+GoCfish_Class_set_wrap_index(Class *klass, size_t index) {
+    // Readers who see the index must also see the registered WRAP function.
+    Atomic_store_release_ptr(&klass->host_type, (void*)(uintptr_t)index);
+}
+
 void*
 Class_To_Host_IMP(Class *self, void *vcache) {
     UNUSED_VAR(self);
@@ -255,6 +316,23 @@ Err_trap(Err_Attempt_t routine, void *context) {
     return GoCfish_TrapErr(routine, context);
 }
 
+/***************************** HostRuntime *********************************/
+
+void*
+HostRuntime_clone() {
+    return NULL;
+}
+
+void
+HostRuntime_set_current(void *runtime) {
+    UNUSED_VAR(runtime);
+}
+
+void
+HostRuntime_destroy(void *runtime) {
+    UNUSED_VAR(runtime);
+}
+
 /***************************** To_Host methods *****************************/
 
 void*
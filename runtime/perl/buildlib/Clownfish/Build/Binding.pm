@@ -35,6 +35,7 @@ sub bind_all {
     $class->bind_hashiterator;
     $class->bind_float;
     $class->bind_integer;
+    $class->bind_num_arrays;
     $class->bind_obj;
     $class->bind_vector;
     $class->bind_class;
@@ -107,6 +108,7 @@ sub bind_test_host {
         alias  => 'perl_alias',
         method => 'Aliased',
     );
+    $binding->fast_callback('Fast_Callback');
     Clownfish::CFC::Binding::Perl::Class->register($binding);
 }
 
@@ -440,6 +442,35 @@ END_SYNOPSIS
     my $xs_code = <<'END_XS_CODE';
 MODULE = Clownfish    PACKAGE = Clownfish::Err
 
+BOOT:
+    XSBind_init_err_context(aTHX);
+
+void
+CLONE(class_sv)
+    SV *class_sv;
+PPCODE:
+    /* CLONE is also invoked for subclasses of Err. */
+    if (strEQ(SvPV_nolen(class_sv), "Clownfish::Err")) {
+        XSBind_clone_err_context(aTHX);
+    }
+
+SV*
+get_error(...)
+CODE:
+    CFISH_UNUSED_VAR(items);
+    RETVAL = XSBind_cfish_to_perl(aTHX_ (cfish_Obj*)cfish_Err_get_error());
+OUTPUT: RETVAL
+
+void
+set_error(unused_sv, error_sv)
+    SV *unused_sv;
+    SV *error_sv;
+PPCODE:
+    CFISH_UNUSED_VAR(unused_sv);
+    cfish_Err *error = (cfish_Err*)XSBind_perl_to_cfish_nullable(
+            aTHX_ error_sv, CFISH_ERR);
+    cfish_Err_set_error(error);
+
 SV*
 trap(routine_sv, context_sv)
     SV *routine_sv;
@@ -639,6 +670,90 @@ END_XS_CODE
     Clownfish::CFC::Binding::Perl::Class->register($binding);
 }
 
+sub bind_num_arrays {
+    my %specs = (
+        'Clownfish::I32Array' => [ 'cfish_I32Array', 'I32Arr', 'int32_t', 'l' ],
+        'Clownfish::I64Array' => [ 'cfish_I64Array', 'I64Arr', 'int64_t', 'q' ],
+        'Clownfish::F64Array' => [ 'cfish_F64Array', 'F64Arr', 'double',  'd' ],
+    );
+
+    for my $class_name ( sort keys %specs ) {
+        my ( $struct, $nick, $type, $template ) = @{ $specs{$class_name} };
+
+        my $pod_spec = Clownfish::CFC::Binding::Perl::Pod->new;
+        my $synopsis = <<"END_SYNOPSIS";
+    my \$array = $class_name->new_from_packed( pack( '$template*', \@nums ) );
+    my \@nums  = unpack( '$template*', \$array->to_packed );
+END_SYNOPSIS
+        my $new_from_packed_pod = <<"END_POD";
+=head2 new_from_packed
+
+    my \$array = $class_name->new_from_packed(\$packed);
+
+Create an array from a string of native-endian C<$type> values as produced
+by C<pack('$template*', ...)>.
+END_POD
+        my $to_packed_pod = <<"END_POD";
+=head2 to_packed
+
+    my \$packed = \$array->to_packed;
+
+Return a read-only string which aliases the array's buffer without copying.
+The array can't be grown while the string is alive.
+END_POD
+        $pod_spec->set_synopsis($synopsis);
+        $pod_spec->add_constructor();
+        $pod_spec->add_method(
+            alias  => 'new_from_packed',
+            pod    => $new_from_packed_pod,
+        );
+        $pod_spec->add_method(
+            alias  => 'to_packed',
+            pod    => $to_packed_pod,
+        );
+
+        my $xs_code = <<"END_XS_CODE";
+MODULE = Clownfish   PACKAGE = $class_name
+
+SV*
+new_from_packed(either_sv, sv)
+    SV *either_sv;
+    SV *sv;
+CODE:
+{
+    STRLEN  size;
+    char   *ptr = SvPV(sv, size);
+    if (size % sizeof($type) != 0) {
+        THROW(CFISH_ERR, "Packed string size %u64 isn't a multiple of %u64",
+              (uint64_t)size, (uint64_t)sizeof($type));
+    }
+    size_t num_elems = size / sizeof($type);
+    $struct *self = ($struct*)XSBind_new_blank_obj(aTHX_ either_sv);
+    cfish_${nick}_init(self, num_elems);
+    CFISH_${nick}_Resize(self, num_elems);
+    memcpy(CFISH_${nick}_Get_Ptr(self), ptr, size);
+    RETVAL = CFISH_OBJ_TO_SV_NOINC(self);
+}
+OUTPUT: RETVAL
+
+SV*
+to_packed(self)
+    $struct *self;
+CODE:
+    RETVAL = XSBind_num_array_to_packed(aTHX_ (cfish_Obj*)self);
+OUTPUT: RETVAL
+END_XS_CODE
+
+        my $binding = Clownfish::CFC::Binding::Perl::Class->new(
+            class_name => $class_name,
+        );
+        $binding->set_pod_spec($pod_spec);
+        $binding->append_xs($xs_code);
+
+        Clownfish::CFC::Binding::Perl::Class->register($binding);
+    }
+}
+
 sub bind_obj {
     my @hand_rolled = qw( Destroy );
 
@@ -800,6 +915,8 @@ END_XS_CODE
     $binding->append_xs($xs_code);
     $binding->set_pod_spec($pod_spec);
     $binding->exclude_method($_) for @hand_rolled;
+    # Called in hot loops like Vector#sort.
+    $binding->fast_callback('Compare_To');
 
     Clownfish::CFC::Binding::Perl::Class->register($binding);
 }
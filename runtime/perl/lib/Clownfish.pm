@@ -41,7 +41,7 @@ BEGIN {
     bootstrap Clownfish '0.6.0';
 }
 
-sub error {$Clownfish::Err::error}
+sub error { Clownfish::Err->get_error }
 
 {
     package Clownfish::Obj;
@@ -119,8 +119,7 @@ sub error {$Clownfish::Err::error}
     our $VERSION = '0.006000';
     $VERSION = eval $VERSION;
     sub do_to_string { shift->to_string }
-    use Scalar::Util qw( blessed );
-    use Carp qw( confess longmess );
+    use Carp qw( longmess );
     use overload
         '""'     => \&do_to_string,
         fallback => 1;
@@ -140,17 +139,8 @@ sub error {$Clownfish::Err::error}
         die $err;
     }
 
-    our $error;
-    sub set_error {
-        my $val = $_[1];
-        if ( defined $val ) {
-            confess("Not a Clownfish::Err")
-                unless ( blessed($val)
-                && $val->isa("Clownfish::Err") );
-        }
-        $error = $val;
-    }
-    sub get_error {$error}
+    # Release the current error before global destruction.
+    END { Clownfish::Err->set_error(undef) }
 }
 
 {
@@ -16,7 +16,7 @@
 use strict;
 use warnings;
 
-use Test::More tests => 39;
+use Test::More tests => 50;
 use Clownfish qw( to_clownfish );
 use Clownfish::Test;
 
@@ -101,6 +101,46 @@ is( $retval, 101, "undef labeled int32 arg w/default" );
 $retval = $th->test_int32_label_arg_def();
 is( $retval, 101, "empty labeled int32 arg w/default" );
 
+# Generated XSUBs locate labeled args with a per-XSUB label lookup and a
+# fast path for labels passed in declaration order.
+$retval = $th->test_int32_label_arg( arg => 103, unused => 1 );
+is( $retval, 103, "labeled args in order" );
+$retval = $th->test_int32_label_arg( unused => 1, arg => 104 );
+is( $retval, 104, "labeled args out of order" );
+$retval = $th->test_int32_label_arg( arg => 105, arg => 106 );
+is( $retval, 106, "last duplicate labeled arg wins" );
+eval { $th->test_int32_label_arg( arg => 107, unusex => 1 ) };
+like( $@, qr/Invalid parameter: 'unusex'/,
+    "die on invalid label with the length of a valid one" );
+eval { $th->test_int32_label_arg( arg => 107, bogus => 1 ) };
+like( $@, qr/Invalid parameter: 'bogus'/, "die on invalid label" );
+eval { $th->test_int32_label_arg( unused => 1 ) };
+like( $@, qr/Missing required parameter: 'arg'/,
+    "die on missing labeled arg" );
+
+# Hand-written XSUBs like Class->singleton use the generic lookup.
+my $obj_class = Clownfish::Class->fetch_class('Clownfish::Obj');
+my $klass = Clownfish::Class->singleton( class_name => 'Clownfish::Hash' );
+is( $klass->get_name, 'Clownfish::Hash', "generic lookup: labeled arg" );
+$klass = Clownfish::Class->singleton(
+    parent     => $obj_class,
+    class_name => 'LabeledSingletonTestObj',
+);
+is( $klass->get_name, 'LabeledSingletonTestObj',
+    "generic lookup: labeled args out of order" );
+$klass = Clownfish::Class->singleton(
+    class_name => 'Clownfish::Vector',
+    class_name => 'Clownfish::Hash',
+);
+is( $klass->get_name, 'Clownfish::Hash',
+    "generic lookup: last duplicate labeled arg wins" );
+eval { Clownfish::Class->singleton( class_nam => 'Clownfish::Hash' ) };
+like( $@, qr/Invalid parameter: 'class_nam'/,
+    "generic lookup: die on invalid label" );
+eval { Clownfish::Class->singleton( parent => $obj_class ) };
+like( $@, qr/Missing required parameter: 'class_name'/,
+    "generic lookup: die on missing labeled arg" );
+
 $retval = $th->test_bool_pos_arg(1);
 ok( $retval, "true positional bool arg" );
 $retval = $th->test_bool_pos_arg(0);
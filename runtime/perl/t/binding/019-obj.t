@@ -16,7 +16,8 @@
 use strict;
 use warnings;
 
-use Test::More tests => 33;
+use Test::More tests => 38;
+use Config;
 use Scalar::Util qw( refaddr reftype );
 use Clownfish::Test;
 
@@ -59,6 +60,26 @@ use base qw( Clownfish::Test::TestHost );
     sub perl_alias {"Perl"}
 }
 
+package FastCallbackTestObj;
+use base qw( Clownfish::Test::TestHost );
+{
+    sub fast_callback {
+        my ( $self, $a, $b ) = @_;
+        return $a - $b;
+    }
+}
+
+package AutoloadFastCallbackTestObj;
+use base qw( Clownfish::Test::TestHost );
+{
+    our $AUTOLOAD;
+    sub AUTOLOAD {
+        my ( $self, $a, $b ) = @_;
+        my ( $name ) = $AUTOLOAD =~ /(\w+)$/;
+        return $name eq 'fast_callback' ? $a * $b : 0;
+    }
+}
+
 package SubclassFinalTestObj;
 use base qw( Clownfish::Vector );
 
@@ -170,6 +191,33 @@ my $overridden_alias_test = OverriddenAliasTestObj->new;
 is( $overridden_alias_test->invoke_aliased_from_c, 'Perl',
     'Overriding aliased methods works' );
 
+my $fast_callback_test = FastCallbackTestObj->new;
+is( $fast_callback_test->invoke_fast_callback_from_c( a => 5, b => 3 ), 2,
+    'Fast callbacks receive positional args' );
+
+my $autoload_test = AutoloadFastCallbackTestObj->new;
+for my $round ( 1 .. 2 ) {
+    $AutoloadFastCallbackTestObj::AUTOLOAD = undef;
+    is( $autoload_test->invoke_fast_callback_from_c( a => 5, b => 3 ), 15,
+        "Fast callbacks resolve AUTOLOAD (round $round)" );
+}
+
+SKIP: {
+    skip( "ithreads not available", 2 ) if !$Config{useithreads};
+    require threads;
+
+    # Resolve the CV in the main interpreter, then call it from a clone
+    # which must not use the cached CV.
+    $fast_callback_test->invoke_fast_callback_from_c( a => 5, b => 3 );
+    for my $round ( 1 .. 2 ) {
+        my $thread = threads->create( sub {
+            my $obj = FastCallbackTestObj->new;
+            return $obj->invoke_fast_callback_from_c( a => 7, b => 3 );
+        } );
+        is( $thread->join, 4, "Fast callbacks work in threads (round $round)" );
+    }
+}
+
 eval { SubclassFinalTestObj->new; };
 like( $@, qr/Can't subclass final class Clownfish::Vector/,
       "Final class can't be subclassed" );
@@ -0,0 +1,53 @@
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.
+# The ASF licenses this file to You under the Apache License, Version 2.0
+# (the "License"); you may not use this file except in compliance with
+# the License.  You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+use strict;
+use warnings;
+
+use Test::More tests => 7;
+use Config;
+use Clownfish;
+
+my @nums   = ( 3, -1, 42, 7 );
+my $i32    = Clownfish::I32Array->new_from_packed( pack( 'l*', @nums ) );
+my $packed = $i32->to_packed;
+is_deeply( [ unpack( 'l*', $packed ) ], \@nums, 'I32Array round trip' );
+is( length($packed), 16, 'to_packed length' );
+
+my $f64 = Clownfish::F64Array->new_from_packed( pack( 'd*', 0.5, -2.25 ) );
+is_deeply( [ unpack( 'd*', $f64->to_packed ) ], [ 0.5, -2.25 ],
+    'F64Array round trip' );
+
+eval { substr( $packed, 0, 1, 'x' ); };
+like( $@, qr/read-only/, 'packed view is read-only' );
+
+undef $i32;
+is_deeply( [ unpack( 'l*', $packed ) ], \@nums,
+    'packed view outlives the Perl wrapper' );
+
+SKIP: {
+    skip( "ithreads not available", 2 ) if !$Config{useithreads};
+    require threads;
+
+    # The clone gets its own copy of the bytes and must not release the
+    # parent's export.
+    my $thread = threads->create( sub {
+        return join( ',', unpack( 'l*', $packed ) );
+    } );
+    is( $thread->join, join( ',', @nums ), 'packed view cloned by thread' );
+    undef $packed;
+    pass( 'packed view freed after thread joined' );
+}
+
@@ -27,7 +27,7 @@ package GloriousDeath;
 use base qw( Clownfish::Err );
 
 package main;
-use Test::More tests => 12;
+use Test::More tests => 17;
 
 my $err = Clownfish::Err->new("Bad stuff happened");
 isa_ok( $err, 'Clownfish::Err', "new" );
@@ -62,6 +62,15 @@ my $succeed = sub { };
 ok( !defined( Clownfish::Err::trap( $succeed, undef ) ),
     "nothing to trap" );
 
+ok( !defined( Clownfish->error ), "no error initially" );
+Clownfish::Err->set_error($glorious);
+is( Clownfish::Err->get_error, $glorious, "set_error and get_error" );
+is( Clownfish->error, $glorious, "Clownfish->error" );
+Clownfish::Err->set_error(undef);
+ok( !defined( Clownfish::Err->get_error ), "clear error" );
+eval { Clownfish::Err->set_error("not an Err") };
+like( $@, qr/Clownfish::Err/, "set_error rejects non-Err" );
+
 sub bite_the_dust { die Clownfish::Err->new("gasp") }
 
 sub judge_gladiator {
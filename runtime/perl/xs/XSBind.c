@@ -22,6 +22,7 @@
 #define C_CFISH_FLOAT
 #define C_CFISH_INTEGER
 #define C_CFISH_BOOLEAN
+#define C_CFISH_NUMARRAY
 #define NEED_newRV_noinc
 #include "charmony.h"
 #include "XSBind.h"
@@ -30,9 +31,10 @@
 #include "Clownfish/HashIterator.h"
 #include "Clownfish/Method.h"
 #include "Clownfish/Num.h"
+#include "Clownfish/NumArray.h"
 #include "Clownfish/PtrHash.h"
-#include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/HostRuntime.h"
 #include "Clownfish/Util/Memory.h"
 
 // Support older Perls.
@@ -71,6 +73,11 @@ S_mortalize_wrapper(pTHX_ cfish_Obj *obj);
 static void
 S_destroy_wrapper(cfish_HostObjWrapper *wrapper);
 
+// Return an ID for the current interpreter.  IDs are never reused, not even
+// after an interpreter has been freed.
+static size_t
+S_interp_id(pTHX);
+
 static bool
 S_maybe_perl_to_cfish(pTHX_ SV *sv, cfish_Class *klass, bool increment,
                       void *allocation, cfish_ConversionCache *cache,
@@ -515,10 +522,24 @@ XSBind_trap(SV *routine, SV *context) {
     return cfish_Err_trap(S_attempt_perl_call, &args);
 }
 
-void
-cfish_XSBind_locate_args(pTHX_ SV** stack, int32_t start, int32_t items,
-                         const XSBind_ParamSpec *specs, int32_t *locations,
-                         int32_t num_params) {
+static int32_t
+S_label_index(const XSBind_ParamSpec *specs, int32_t num_params,
+              const char *label, STRLEN label_len) {
+    for (int32_t i = 0; i < num_params; i++) {
+        const XSBind_ParamSpec *spec = &specs[i];
+        if (label_len == (STRLEN)spec->label_len
+            && memcmp(label, spec->label, label_len) == 0
+           ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void
+S_locate_args(pTHX_ SV** stack, int32_t start, int32_t items,
+              const XSBind_ParamSpec *specs, XSBind_LabelIndex_t label_index,
+              int32_t *locations, int32_t num_params) {
     // Verify that our args come in pairs.
     if ((items - start) % 2 != 0) {
         THROW(CFISH_ERR,
@@ -526,64 +547,69 @@ cfish_XSBind_locate_args(pTHX_ SV** stack, int32_t start, int32_t items,
         return;
     }
 
-    int32_t num_consumed = 0;
     for (int32_t i = 0; i < num_params; i++) {
-        const XSBind_ParamSpec *spec = &specs[i];
+        locations[i] = items;
+    }
 
-        // Iterate through the stack looking for labels which match this param
-        // name.  If the label appears more than once, keep track of where it
-        // appears *last*, as the last time a param appears overrides all
-        // previous appearances.
-        int32_t location = items;
-        for (int32_t tick = start; tick < items; tick += 2) {
-            SV *const key_sv = stack[tick];
-            if (SvCUR(key_sv) == (STRLEN)spec->label_len) {
-                if (memcmp(SvPVX(key_sv), spec->label, spec->label_len) == 0) {
-                    location = tick + 1;
-                    ++num_consumed;
-                }
-            }
+    // Fast path: Labels passed in the order they were declared can be
+    // checked against a single param spec.
+    int32_t tick = start;
+    for (int32_t i = 0; i < num_params && tick < items; i++, tick += 2) {
+        const XSBind_ParamSpec *spec = &specs[i];
+        SV *const key_sv = stack[tick];
+        if (SvCUR(key_sv) != (STRLEN)spec->label_len
+            || memcmp(SvPVX(key_sv), spec->label, spec->label_len) != 0
+           ) {
+            break;
         }
-
-        // Didn't find this parameter. Throw an error if it was required.
-        if (location == items && spec->required) {
-            THROW(CFISH_ERR, "Missing required parameter: '%s'", spec->label);
+        locations[i] = tick + 1;
+    }
+
+    // Look up the remaining labels.  If a label appears more than once, the
+    // last appearance overrides all previous ones.
+    for (; tick < items; tick += 2) {
+        SV *const key_sv = stack[tick];
+        const char *key = SvPVX(key_sv);
+        STRLEN key_len = SvCUR(key_sv);
+        int32_t i = label_index
+                    ? label_index(key, key_len)
+                    : S_label_index(specs, num_params, key, key_len);
+        if (i < 0) {
+            const char *key_c = SvPV_nolen(key_sv);
+            THROW(CFISH_ERR, "Invalid parameter: '%s'", key_c);
             return;
         }
-
-        // Store the location.
-        locations[i] = location;
+        locations[i] = tick + 1;
     }
 
-    // Ensure that all parameter labels were valid.
-    if (num_consumed != (items - start) / 2) {
-        // Find invalid parameter.
-        for (int32_t tick = start; tick < items; tick += 2) {
-            SV *const key_sv = stack[tick];
-            const char *key = SvPVX(key_sv);
-            STRLEN key_len = SvCUR(key_sv);
-            bool found = false;
-
-            for (int32_t i = 0; i < num_params; ++i) {
-                const XSBind_ParamSpec *spec = &specs[i];
-
-                if (key_len == (STRLEN)spec->label_len
-                    && memcmp(key, spec->label, key_len) == 0
-                   ) {
-                    found = true;
-                    break;
-                }
-            }
-
-            if (!found) {
-                const char *key_c = SvPV_nolen(key_sv);
-                THROW(CFISH_ERR, "Invalid parameter: '%s'", key_c);
-                return;
-            }
+    // Throw an error if a required param wasn't found.
+    for (int32_t i = 0; i < num_params; i++) {
+        if (locations[i] == items && specs[i].required) {
+            THROW(CFISH_ERR, "Missing required parameter: '%s'",
+                  specs[i].label);
+            return;
         }
     }
 }
 
+void
+cfish_XSBind_locate_args(pTHX_ SV** stack, int32_t start, int32_t items,
+                         const XSBind_ParamSpec *specs, int32_t *locations,
+                         int32_t num_params) {
+    S_locate_args(aTHX_ stack, start, items, specs, NULL, locations,
+                  num_params);
+}
+
+void
+cfish_XSBind_locate_indexed_args(pTHX_ SV** stack, int32_t start,
+                                 int32_t items,
+                                 const XSBind_ParamSpec *specs,
+                                 XSBind_LabelIndex_t label_index,
+                                 int32_t *locations, int32_t num_params) {
+    S_locate_args(aTHX_ stack, start, items, specs, label_index, locations,
+                  num_params);
+}
+
 cfish_Obj*
 XSBind_arg_to_cfish(pTHX_ SV *value, const char *label, cfish_Class *klass,
                     void *allocation) {
@@ -707,6 +733,67 @@ XSBind_destroy(pTHX_ SV *sv) {
     }
 }
 
+// Per-class cache of the CVs resolved by fast callbacks, stored in
+// `klass->host_type` and indexed by method offset.  CVs belong to a single
+// interpreter, so only the interpreter which created the cache uses it.
+typedef struct {
+    size_t  owner;
+    CV     *cvs[1]; /* flexible array */
+} cfish_XSBind_CallbackCache;
+
+CV*
+XSBind_callback_cv(pTHX_ cfish_Obj *self, SV *self_sv, uint32_t offset,
+                   const char *meth_name) {
+    cfish_Class *klass = self->klass;
+    size_t index = offset / sizeof(cfish_method_t);
+    size_t interp_id = S_interp_id(aTHX);
+    cfish_XSBind_CallbackCache *cache
+        = (cfish_XSBind_CallbackCache*)
+          cfish_Atomic_load_acquire_ptr(&klass->host_type);
+
+    if (cache == NULL) {
+        size_t num_slots = klass->class_alloc_size / sizeof(cfish_method_t);
+        size_t size = sizeof(cfish_XSBind_CallbackCache)
+                      + num_slots * sizeof(CV*);
+        cache = (cfish_XSBind_CallbackCache*)CFISH_CALLOCATE(1, size);
+        cache->owner = interp_id;
+        if (!cfish_Atomic_cas_ptr((void**)&klass->host_type, NULL, cache)) {
+            CFISH_FREEMEM(cache);
+            cache = (cfish_XSBind_CallbackCache*)
+                    cfish_Atomic_load_acquire_ptr(&klass->host_type);
+        }
+    }
+
+    int owned = cache->owner == interp_id;
+    if (owned && cache->cvs[index]) {
+        return cache->cvs[index];
+    }
+
+    HV *stash = SvSTASH(SvRV(self_sv));
+    GV *gv = gv_fetchmeth(stash, meth_name, strlen(meth_name), 0);
+    if (!gv) {
+        // Fall back to AUTOLOAD.  This sets $AUTOLOAD, so the result must
+        // not be cached.
+        gv = gv_fetchmethod_autoload(stash, meth_name, TRUE);
+        owned = false;
+    }
+    CV *cv = gv == NULL ? NULL
+             : isGV(gv) ? GvCV(gv)
+             : (CV*)gv;
+    if (cv == NULL) {
+        THROW(CFISH_ERR, "Can't locate object method '%s' via package '%s'",
+              meth_name, HvNAME(stash));
+    }
+
+    if (owned) {
+        // Classes are never freed, so the CV is kept alive, too.
+        SvREFCNT_inc_simple_void_NN((SV*)cv);
+        cache->cvs[index] = cv;
+    }
+
+    return cv;
+}
+
 /***************************************************************************
  * The routines below are declared within the Clownfish core but left
  * unimplemented and must be defined for each host language.
@@ -938,6 +1025,14 @@ CFISH_Obj_To_Host_IMP(cfish_Obj *self, void *vcache) {
     return XSBind_cfish_obj_to_sv_inc(aTHX_ self);
 }
 
+bool
+cfish_Obj_make_shared(cfish_Obj *self) {
+    // Perl objects can't be shared between interpreters, so refcounts are
+    // never touched concurrently.
+    CFISH_UNUSED_VAR(self);
+    return false;
+}
+
 /*************************** Clownfish::Class ******************************/
 
 cfish_Obj*
@@ -1102,6 +1197,41 @@ CFISH_Method_Host_Name_IMP(cfish_Method *self) {
 
 /***************************** Clownfish::Err *******************************/
 
+// The current error is kept in a per-interpreter C struct, so that
+// Err_get_error and Err_set_error don't have to call into Perl.  The struct
+// also holds the ID which marks the owner of fast callback caches.
+#define MY_CXT_KEY "Clownfish::Err::_guts"
+
+typedef struct {
+    cfish_Err *current_error;
+    size_t     interp_id;
+} my_cxt_t;
+
+START_MY_CXT
+
+static size_t interp_count = 0;
+
+void
+cfish_XSBind_init_err_context(pTHX) {
+    MY_CXT_INIT;
+    MY_CXT.current_error = NULL;
+    MY_CXT.interp_id     = cfish_Atomic_incr_size(&interp_count);
+}
+
+void
+cfish_XSBind_clone_err_context(pTHX) {
+    MY_CXT_CLONE;
+    // Clownfish objects aren't cloned into new interpreters.
+    MY_CXT.current_error = NULL;
+    MY_CXT.interp_id     = cfish_Atomic_incr_size(&interp_count);
+}
+
+static size_t
+S_interp_id(pTHX) {
+    dMY_CXT;
+    return MY_CXT.interp_id;
+}
+
 // Anonymous XSUB helper for Err#trap().  It wraps the supplied C function
 // so that it can be run inside a Perl eval block.
 static SV *attempt_xsub = NULL;
@@ -1134,42 +1264,17 @@ cfish_Err_init_class(void) {
 cfish_Err*
 cfish_Err_get_error() {
     dTHX;
-    dSP;
-    ENTER;
-    SAVETMPS;
-    PUSHMARK(SP);
-    PUTBACK;
-    call_pv("Clownfish::Err::get_error", G_SCALAR);
-    SPAGAIN;
-    cfish_Err *error
-        = (cfish_Err*)XSBind_perl_to_cfish_nullable(aTHX_ POPs, CFISH_ERR);
-    PUTBACK;
-    FREETMPS;
-    LEAVE;
-    CFISH_DECREF(error);
-    return error;
+    dMY_CXT;
+    return MY_CXT.current_error;
 }
 
 void
 cfish_Err_set_error(cfish_Err *error) {
     dTHX;
-    dSP;
-    ENTER;
-    SAVETMPS;
-    EXTEND(SP, 2);
-    PUSHMARK(SP);
-    PUSHmortal;
-    if (error) {
-        mPUSHs((SV*)CFISH_Err_To_Host(error, NULL));
-    }
-    else {
-        PUSHmortal;
-    }
-    PUTBACK;
-    call_pv("Clownfish::Err::set_error", G_VOID | G_DISCARD);
-    FREETMPS;
-    LEAVE;
-    CFISH_DECREF(error);
+    dMY_CXT;
+    cfish_Err *old_error = MY_CXT.current_error;
+    MY_CXT.current_error = error;
+    CFISH_DECREF(old_error);
 }
 
 void
@@ -1441,13 +1546,81 @@ CFISH_Bool_To_Host_IMP(cfish_Boolean *self, void *vcache) {
     return newSViv((IV)self->value);
 }
 
-/********************* Clownfish::TestHarness::TestUtils ********************/
+/************************** Clownfish::NumArray *****************************/
+
+static int
+S_release_packed_view(pTHX_ SV *sv, MAGIC *mg) {
+    cfish_NumArray *array = (cfish_NumArray*)mg->mg_ptr;
+    if (array == NULL) {
+        // Disarmed by S_dup_packed_view, the SV owns its buffer.
+        return 0;
+    }
+    cfish_NumArr_remove_export(array);
+    // Detach the borrowed buffer so that Perl won't try to free it.
+    SvPV_set(sv, NULL);
+    SvCUR_set(sv, 0);
+    SvOK_off(sv);
+    mg->mg_ptr = NULL;
+    CFISH_DECREF(array);
+    return 0;
+}
+
+// Called when an ithread clones the interpreter. The cloned SV still aliases
+// the original array's buffer, but it must not touch the array which belongs
+// to the parent thread. Give the clone a private copy of the bytes and
+// disarm its magic so that only the original SV releases the export.
+static int
+S_dup_packed_view(pTHX_ MAGIC *mg, CLONE_PARAMS *param) {
+    CFISH_UNUSED_VAR(param);
+    SV     *sv  = mg->mg_obj;
+    STRLEN  len = SvCUR(sv);
+    char   *copy;
+    Newx(copy, len + 1, char);
+    Copy(SvPVX(sv), copy, len, char);
+    copy[len] = '\0';
+    SvPV_set(sv, copy);
+    SvLEN_set(sv, len + 1);
+    mg->mg_ptr = NULL;
+    return 0;
+}
+
+static MGVTBL packed_view_vtbl = {
+    NULL, NULL, NULL, NULL, S_release_packed_view, NULL, S_dup_packed_view,
+    NULL
+};
+
+SV*
+cfish_XSBind_num_array_to_packed(pTHX_ cfish_Obj *obj) {
+    cfish_NumArray *array
+        = (cfish_NumArray*)CFISH_CERTIFY(obj, CFISH_NUMARRAY);
+
+    // Alias the array's buffer instead of copying it. SvLEN of zero tells
+    // Perl that it doesn't own the buffer.
+    SV *sv = newSV_type(SVt_PVMG);
+    SvPV_set(sv, (char*)array->elems);
+    SvCUR_set(sv, array->size * array->width);
+    SvLEN_set(sv, 0);
+    SvPOK_only(sv);
+    // The SV itself is stored as mg_obj (without a refcount) so that the
+    // dup handler can find the cloned SV.
+    MAGIC *mg = sv_magicext(sv, sv, PERL_MAGIC_ext, &packed_view_vtbl,
+                            (char*)CFISH_INCREF(array), 0);
+    mg->mg_flags |= MGf_DUP;
+    SvREADONLY_on(sv);
+
+    // Pin the buffer until the SV is freed.
+    cfish_NumArr_add_export(array);
+
+    return sv;
+}
+
+/*********************** Clownfish::Util::HostRuntime ***********************/
 
 
 #ifndef CFISH_NOTHREADS
 
 void*
-cfish_TestUtils_clone_host_runtime() {
+cfish_HostRuntime_clone() {
     PerlInterpreter *interp = (PerlInterpreter*)PERL_GET_CONTEXT;
     PerlInterpreter *clone  = perl_clone(interp, CLONEf_CLONE_HOST);
     PERL_SET_CONTEXT(interp);
@@ -1455,12 +1628,12 @@ cfish_TestUtils_clone_host_runtime() {
 }
 
 void
-cfish_TestUtils_set_host_runtime(void *runtime) {
+cfish_HostRuntime_set_current(void *runtime) {
     PERL_SET_CONTEXT(runtime);
 }
 
 void
-cfish_TestUtils_destroy_host_runtime(void *runtime) {
+cfish_HostRuntime_destroy(void *runtime) {
     PerlInterpreter *current = (PerlInterpreter*)PERL_GET_CONTEXT;
     PerlInterpreter *interp  = (PerlInterpreter*)runtime;
 
@@ -1481,19 +1654,19 @@ cfish_TestUtils_destroy_host_runtime(void *runtime) {
 #else /* CFISH_NOTHREADS */
 
 void*
-cfish_TestUtils_clone_host_runtime() {
+cfish_HostRuntime_clone() {
     CFISH_THROW(CFISH_ERR, "No thread support");
     CFISH_UNREACHABLE_RETURN(void*);
 }
 
 void
-cfish_TestUtils_set_host_runtime(void *runtime) {
+cfish_HostRuntime_set_current(void *runtime) {
     CFISH_UNUSED_VAR(runtime);
     CFISH_THROW(CFISH_ERR, "No thread support");
 }
 
 void
-cfish_TestUtils_destroy_host_runtime(void *runtime) {
+cfish_HostRuntime_destroy(void *runtime) {
     CFISH_UNUSED_VAR(runtime);
     CFISH_THROW(CFISH_ERR, "No thread support");
 }
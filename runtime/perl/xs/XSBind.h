@@ -61,6 +61,13 @@ typedef struct cfish_XSBind_ParamSpec {
     char        required;
 } cfish_XSBind_ParamSpec;
 
+/** Map a parameter label to its index in the param specs of an XSUB, or
+ * return -1 if the label is invalid.  Generated by CFC for every XSUB with
+ * labeled params.
+ */
+typedef int32_t
+(*cfish_XSBind_LabelIndex_t)(const char *label, STRLEN label_len);
+
 /** Given either a class name or a perl object, manufacture a new Clownfish
  * object suitable for supplying to a cfish_Foo_init() function.
  */
@@ -111,6 +118,13 @@ cfish_XSBind_cfish_obj_to_sv_noinc(pTHX_ cfish_Obj *obj);
 #define CFISH_OBJ_TO_SV_NOINC(_obj) \
     cfish_XSBind_cfish_obj_to_sv_noinc(aTHX_ (cfish_Obj*)_obj)
 
+/** Return a read-only SV whose string buffer aliases the elements of an
+ * I32Array, I64Array or F64Array. The array can't be reallocated while the
+ * SV is alive.
+ */
+CFISH_VISIBLE SV*
+cfish_XSBind_num_array_to_packed(pTHX_ cfish_Obj *obj);
+
 /** Null-safe invocation of Obj_To_Host.
  */
 static CFISH_INLINE SV*
@@ -162,6 +176,17 @@ cfish_XSBind_hash_key_to_utf8(pTHX_ HE *entry, STRLEN *size_ptr);
 cfish_Err*
 cfish_XSBind_trap(SV *routine, SV *context);
 
+/** Set up the per-interpreter storage for the current error.  Must be called
+ * once when the Clownfish module is loaded.
+ */
+CFISH_VISIBLE void
+cfish_XSBind_init_err_context(pTHX);
+
+/** Set up fresh per-interpreter error storage in a cloned interpreter.
+ */
+CFISH_VISIBLE void
+cfish_XSBind_clone_err_context(pTHX);
+
 /** Locate hash-style params passed to an XS subroutine.  If a required
  * parameter is not present, locate_args() will throw an error.
  *
@@ -186,6 +211,16 @@ cfish_XSBind_locate_args(pTHX_ SV** stack, int32_t start, int32_t items,
                          const cfish_XSBind_ParamSpec *specs,
                          int32_t *locations, int32_t num_params);
 
+/** Like locate_args(), but map labels to params with `label_index` instead
+ * of comparing them against every param spec.
+ */
+CFISH_VISIBLE void
+cfish_XSBind_locate_indexed_args(pTHX_ SV** stack, int32_t start,
+                                 int32_t items,
+                                 const cfish_XSBind_ParamSpec *specs,
+                                 cfish_XSBind_LabelIndex_t label_index,
+                                 int32_t *locations, int32_t num_params);
+
 /** Convert an argument from the Perl stack to a Clownfish object. Throws
  * an error if the SV can't be converted.
  *
@@ -227,6 +262,15 @@ cfish_XSBind_bootstrap(pTHX_ size_t num_classes,
 CFISH_VISIBLE void
 cfish_XSBind_destroy(pTHX_ SV *sv);
 
+/** Return the CV which overrides a method in the Perl class of `self`.  Used
+ * by fast callbacks.  The CV is resolved once per class and method offset
+ * and cached in the Class for the interpreter which resolved it first.
+ * Methods found via AUTOLOAD are never cached.
+ */
+CFISH_VISIBLE CV*
+cfish_XSBind_callback_cv(pTHX_ cfish_Obj *self, SV *self_sv, uint32_t offset,
+                         const char *meth_name);
+
 #define XSBIND_PARAM(key, required) \
     { key, (int16_t)sizeof("" key) - 1, (char)required }
 
@@ -239,6 +283,7 @@ cfish_XSBind_destroy(pTHX_ SV *sv);
 #define XSBind_ClassSpec               cfish_XSBind_ClassSpec
 #define XSBind_XSubSpec                cfish_XSBind_XSubSpec
 #define XSBind_ParamSpec               cfish_XSBind_ParamSpec
+#define XSBind_LabelIndex_t            cfish_XSBind_LabelIndex_t
 #define XSBind_new_blank_obj           cfish_XSBind_new_blank_obj
 #define XSBind_foster_obj              cfish_XSBind_foster_obj
 #define XSBind_sv_defined              cfish_XSBind_sv_defined
@@ -246,18 +291,23 @@ cfish_XSBind_destroy(pTHX_ SV *sv);
 #define XSBind_cfish_obj_to_sv_inc     cfish_XSBind_cfish_obj_to_sv_inc
 #define XSBind_cfish_obj_to_sv_noinc   cfish_XSBind_cfish_obj_to_sv_noinc
 #define XSBind_cfish_to_perl           cfish_XSBind_cfish_to_perl
+#define XSBind_num_array_to_packed     cfish_XSBind_num_array_to_packed
 #define XSBind_perl_to_cfish           cfish_XSBind_perl_to_cfish
 #define XSBind_perl_to_cfish_nullable  cfish_XSBind_perl_to_cfish_nullable
 #define XSBind_perl_to_cfish_noinc     cfish_XSBind_perl_to_cfish_noinc
 #define XSBind_hash_key_to_utf8        cfish_XSBind_hash_key_to_utf8
 #define XSBind_trap                    cfish_XSBind_trap
+#define XSBind_init_err_context        cfish_XSBind_init_err_context
+#define XSBind_clone_err_context       cfish_XSBind_clone_err_context
 #define XSBind_locate_args             cfish_XSBind_locate_args
+#define XSBind_locate_indexed_args     cfish_XSBind_locate_indexed_args
 #define XSBind_arg_to_cfish            cfish_XSBind_arg_to_cfish
 #define XSBind_arg_to_cfish_nullable   cfish_XSBind_arg_to_cfish_nullable
 #define XSBind_invalid_args_error      cfish_XSBind_invalid_args_error
 #define XSBind_undef_arg_error         cfish_XSBind_undef_arg_error
 #define XSBind_bootstrap               cfish_XSBind_bootstrap
 #define XSBind_destroy                 cfish_XSBind_destroy
+#define XSBind_callback_cv             cfish_XSBind_callback_cv
 
 /* Strip the prefix from some common ClownFish symbols where we know there's
  * no conflict with Perl.  It's a little inconsistent to do this rather than
@@ -18,6 +18,7 @@
 #define C_CFISH_CLASS
 #define C_CFISH_METHOD
 #define C_CFISH_ERR
+#define C_CFISH_NUMARRAY
 
 #include <setjmp.h>
 
@@ -34,9 +35,10 @@
 #include "Clownfish/HashIterator.h"
 #include "Clownfish/Method.h"
 #include "Clownfish/Num.h"
+#include "Clownfish/NumArray.h"
 #include "Clownfish/String.h"
-#include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/HostRuntime.h"
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Vector.h"
 
@@ -766,66 +768,185 @@ CFBind_maybe_convert_bool(PyObject *py_obj, bool *ptr) {
     return S_convert_bool(py_obj, ptr, true);
 }
 
-typedef struct ClassMapElem {
-    cfish_Class **klass_handle;
-    PyTypeObject *py_type;
-} ClassMapElem;
+static int
+S_intern_keywords(const char **keywords, PyObject **py_keywords,
+                  Py_ssize_t num_params) {
+    for (Py_ssize_t i = 0; i < num_params; i++) {
+        if (py_keywords[i] == NULL) {
+            py_keywords[i] = PyUnicode_InternFromString(keywords[i]);
+            if (py_keywords[i] == NULL) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static Py_ssize_t
+S_keyword_index(PyObject *kwname, PyObject **py_keywords,
+                Py_ssize_t num_params) {
+    // Keyword names in calls from Python code are interned, so they can
+    // usually be matched by identity.
+    for (Py_ssize_t i = 0; i < num_params; i++) {
+        if (py_keywords[i] == kwname) {
+            return i;
+        }
+    }
+    for (Py_ssize_t i = 0; i < num_params; i++) {
+        if (PyUnicode_Compare(kwname, py_keywords[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
 
-typedef struct ClassMap {
-    int32_t size;
-    ClassMapElem *elems;
-} ClassMap;
+int
+CFBind_parse_fastcall(PyObject *const *args, Py_ssize_t nargs,
+                      PyObject *kwnames, const char **keywords,
+                      PyObject **py_keywords, Py_ssize_t num_params,
+                      Py_ssize_t num_required, CFBindConverter *converters,
+                      void **targets, PyObject **values) {
+    if (nargs > num_params) {
+        PyErr_Format(PyExc_TypeError,
+                     "function takes at most %zd arguments (%zd given)",
+                     num_params, nargs);
+        return 0;
+    }
+    for (Py_ssize_t i = 0; i < num_params; i++) {
+        values[i] = i < nargs ? args[i] : NULL;
+    }
+
+    if (kwnames != NULL) {
+        if (!S_intern_keywords(keywords, py_keywords, num_params)) {
+            return 0;
+        }
+        Py_ssize_t num_kwargs = PyTuple_GET_SIZE(kwnames);
+        for (Py_ssize_t k = 0; k < num_kwargs; k++) {
+            PyObject *kwname = PyTuple_GET_ITEM(kwnames, k);
+            Py_ssize_t i = S_keyword_index(kwname, py_keywords, num_params);
+            if (i < 0) {
+                PyErr_Format(PyExc_TypeError,
+                             "'%U' is an invalid keyword argument", kwname);
+                return 0;
+            }
+            if (values[i] != NULL) {
+                PyErr_Format(PyExc_TypeError,
+                             "Argument given by name ('%s') and position"
+                             " (%zd)", keywords[i], i + 1);
+                return 0;
+            }
+            values[i] = args[nargs + k];
+        }
+    }
+
+    for (Py_ssize_t i = 0; i < num_required; i++) {
+        if (values[i] == NULL) {
+            PyErr_Format(PyExc_TypeError,
+                         "Required argument '%s' (pos %zd) not found",
+                         keywords[i], i + 1);
+            return 0;
+        }
+    }
+
+    // Convert args, skipping the ones which weren't supplied.  Like
+    // PyArg_ParseTupleAndKeywords, call the converters with NULL to clean
+    // up if a later conversion fails.  `values` is reused to remember which
+    // conversions need cleanup.
+    for (Py_ssize_t i = 0; i < num_params; i++) {
+        if (values[i] == NULL) {
+            continue;
+        }
+        int result = converters[i](values[i], targets[i]);
+        if (result == 0) {
+            for (Py_ssize_t j = 0; j < i; j++) {
+                if (values[j] != NULL) {
+                    converters[j](NULL, targets[j]);
+                }
+            }
+            return 0;
+        }
+        if (result != Py_CLEANUP_SUPPORTED) {
+            values[i] = NULL;
+        }
+    }
+
+    return 1;
+}
+
+/* A batch of associations between Clownfish classes and Python type
+ * objects, registered by a single extension module.  The arrays are owned by
+ * the module and stay valid for the lifetime of the process.
+ */
+typedef struct PyTypeBatch {
+    struct PyTypeBatch *next;
+    cfish_Class     ***klass_handles;
+    PyTypeObject     **py_types;
+    int32_t            num_items;
+    volatile int32_t   resolved;
+} PyTypeBatch;
 
 /* Before we can invoke methods on any Clownfish object safely, we must know
  * about its corresponding Python type object.  This association must be made
  * early in the bootstrapping process, which is tricky.  We can't use any
  * of Clownfish's convenient data structures yet!
+ *
+ * Each module pushes its batch onto a lock-free stack.  Batches are never
+ * copied or removed, so readers can walk the stack without locking and
+ * nothing has to be reclaimed.  Once the classes of a batch have been
+ * bootstrapped, their type objects are stored in `klass->host_type`, and
+ * the batch is skipped from then on.
  */
-static ClassMap *klass_map = NULL;
-
-static ClassMap*
-S_revise_class_map(ClassMap *current, cfish_Class ***klass_handles,
-                   PyTypeObject **py_types, int32_t num_items) {
-    int32_t num_current = current ? current->size : 0;
-    int32_t total = num_current + num_items;
-    ClassMap *revised = (ClassMap*)malloc(sizeof(ClassMap));
-    revised->elems = (ClassMapElem*)malloc(total * sizeof(ClassMapElem));
-    if (current) {
-        size_t size = num_current * sizeof(ClassMapElem);
-        memcpy(revised->elems, current->elems, size);
-    }
-    for (int32_t i = 0; i < num_items; i++) {
-        revised->elems[i + num_current].klass_handle = klass_handles[i];
-        revised->elems[i + num_current].py_type      = py_types[i];
-    }
-    revised->size = total;
-    return revised;
-}
+static PyTypeBatch *volatile py_type_batches = NULL;
 
 void
 CFBind_assoc_py_types(cfish_Class ***klass_handles, PyTypeObject **py_types,
                       int32_t num_items) {
+    if (num_items == 0) {
+        return;
+    }
+    PyTypeBatch *batch = (PyTypeBatch*)malloc(sizeof(PyTypeBatch));
+    batch->klass_handles = klass_handles;
+    batch->py_types      = py_types;
+    batch->num_items     = num_items;
+    batch->resolved      = 0;
     while (1) {
-        ClassMap *current = klass_map;
-        ClassMap *revised = S_revise_class_map(current, klass_handles,
-                                               py_types, num_items);
-        if (cfish_Atomic_cas_ptr((void*volatile*)&klass_map, current, revised)) {
-            if (current) {
-                // TODO: Use read locking.  For now we have to leak this
-                // memory to avoid memory errors in case another thread isn't
-                // done reading it yet.
-
-                //free(current->elems);
-                //free(current);
-            }
+        PyTypeBatch *head = py_type_batches;
+        batch->next = head;
+        if (cfish_Atomic_cas_ptr((void*volatile*)&py_type_batches, head,
+                                 batch)
+           ) {
             break;
         }
-        else {
-            // Another thread beat us to it.  Try again.
-            free(revised->elems);
-            free(revised);
+        // Another thread beat us to it.  Try again.
+    }
+}
+
+/* Store the type objects of all classes in `batch` which have already been
+ * created in their `host_type` slots.  Return true if every class of the
+ * batch has been resolved.
+ */
+static bool
+S_resolve_py_types(PyTypeBatch *batch) {
+    bool complete = true;
+    for (int32_t i = 0; i < batch->num_items; i++) {
+        cfish_Class *klass = *batch->klass_handles[i];
+        if (klass == NULL) {
+            complete = false;
+            continue;
+        }
+        if (klass->host_type != NULL) {
+            continue;
+        }
+        PyTypeObject *py_type = batch->py_types[i];
+        Py_INCREF(py_type);
+        if (!cfish_Atomic_cas_ptr((void*volatile*)&klass->host_type, NULL,
+                                  py_type)
+           ) {
+            // Lost the race to another thread, so get rid of the refcount.
+            Py_DECREF(py_type);
         }
     }
+    return complete;
 }
 
 /**** refcounting **********************************************************/
@@ -869,6 +990,80 @@ CFISH_Obj_To_Host_IMP(cfish_Obj *self, void *vcache) {
     return CFISH_INCREF(self);
 }
 
+bool
+cfish_Obj_make_shared(cfish_Obj *self) {
+    // Python refcounts are protected by the GIL.
+    CFISH_UNUSED_VAR(self);
+    return false;
+}
+
+/**** NumArray *************************************************************/
+
+/* Expose the elements of I32Array, I64Array and F64Array through the buffer
+ * protocol, so that e.g. `memoryview` or numpy can read and write them
+ * without copying.  The array refuses to reallocate while a view is held.
+ */
+static int
+S_num_array_fill_buffer(PyObject *exporter, Py_buffer *view, char *format,
+                        int flags) {
+    cfish_NumArray *self = (cfish_NumArray*)exporter;
+    Py_ssize_t num_elems = (Py_ssize_t)self->size;
+    Py_ssize_t itemsize  = (Py_ssize_t)self->width;
+    if (PyBuffer_FillInfo(view, exporter, self->elems, num_elems * itemsize,
+                          0, flags) < 0) {
+        return -1;
+    }
+    view->itemsize = itemsize;
+    view->format   = (flags & PyBUF_FORMAT) ? format : NULL;
+    if (flags & PyBUF_ND) {
+        // The shape array lives in `internal` and is freed on release.
+        Py_ssize_t *shape = (Py_ssize_t*)PyMem_Malloc(sizeof(Py_ssize_t));
+        if (shape == NULL) {
+            PyErr_NoMemory();
+            view->obj = NULL;
+            Py_DECREF(exporter);
+            return -1;
+        }
+        shape[0]       = num_elems;
+        view->ndim     = 1;
+        view->shape    = shape;
+        view->internal = shape;
+    }
+    cfish_NumArr_add_export(self);
+    return 0;
+}
+
+static int
+S_I32Arr_getbuffer(PyObject *exporter, Py_buffer *view, int flags) {
+    return S_num_array_fill_buffer(exporter, view, "i", flags);
+}
+
+static int
+S_I64Arr_getbuffer(PyObject *exporter, Py_buffer *view, int flags) {
+    return S_num_array_fill_buffer(exporter, view, "q", flags);
+}
+
+static int
+S_F64Arr_getbuffer(PyObject *exporter, Py_buffer *view, int flags) {
+    return S_num_array_fill_buffer(exporter, view, "d", flags);
+}
+
+static void
+S_num_array_releasebuffer(PyObject *exporter, Py_buffer *view) {
+    PyMem_Free(view->internal);
+    cfish_NumArr_remove_export((cfish_NumArray*)exporter);
+}
+
+static PyBufferProcs I32Arr_as_buffer = {
+    S_I32Arr_getbuffer, S_num_array_releasebuffer
+};
+static PyBufferProcs I64Arr_as_buffer = {
+    S_I64Arr_getbuffer, S_num_array_releasebuffer
+};
+static PyBufferProcs F64Arr_as_buffer = {
+    S_F64Arr_getbuffer, S_num_array_releasebuffer
+};
+
 /**** Class ****************************************************************/
 
 /* Tell Python about the size of Clownfish objects, by copying
@@ -896,6 +1091,15 @@ CFBind_class_bootstrap_hook1(cfish_Class *self) {
             py_type->tp_base = S_get_cached_py_type(self->parent);
         }
         py_type->tp_basicsize = self->obj_alloc_size;
+        if (self == CFISH_I32ARRAY) {
+            py_type->tp_as_buffer = &I32Arr_as_buffer;
+        }
+        else if (self == CFISH_I64ARRAY) {
+            py_type->tp_as_buffer = &I64Arr_as_buffer;
+        }
+        else if (self == CFISH_F64ARRAY) {
+            py_type->tp_as_buffer = &F64Arr_as_buffer;
+        }
         if (PyType_Ready(py_type) < 0) {
             fprintf(stderr, "PyType_Ready failed for %s\n",
                     py_type->tp_name),
@@ -905,27 +1109,23 @@ CFBind_class_bootstrap_hook1(cfish_Class *self) {
 }
 
 /* Check the Class object for its associated PyTypeObject, which is stored in
- * `klass->host_type`.  If it is not there yet, search the class mapping and
- * cache it in the object.  Return the PyTypeObject.
+ * `klass->host_type`.  If it is not there yet, resolve the pending batches
+ * of type associations until it shows up.  Return the PyTypeObject.
  */
 static PyTypeObject*
 S_get_cached_py_type(cfish_Class *self) {
     PyTypeObject *py_type = (PyTypeObject*)self->host_type;
-    if (py_type == NULL) {
-        ClassMap *current = klass_map;
-        for (int32_t i = 0; i < current->size; i++) {
-            cfish_Class **handle = current->elems[i].klass_handle;
-            if (handle == NULL || *handle != self) {
-                continue;
-            }
-            py_type = current->elems[i].py_type;
-            Py_INCREF(py_type);
-            if (!cfish_Atomic_cas_ptr((void*volatile*)&self->host_type, py_type, NULL)) {
-                // Lost the race to another thread, so get rid of the refcount.
-                Py_DECREF(py_type);
-            }
-            break;
+    for (PyTypeBatch *batch = py_type_batches;
+         py_type == NULL && batch != NULL;
+         batch = batch->next
+        ) {
+        if (batch->resolved) {
+            continue;
+        }
+        if (S_resolve_py_types(batch)) {
+            batch->resolved = 1;
         }
+        py_type = (PyTypeObject*)self->host_type;
     }
     if (py_type == NULL) {
         if (Err_initialized) {
@@ -1098,24 +1298,24 @@ cfish_Err_trap(CFISH_Err_Attempt_t routine, void *context) {
     return error;
 }
 
-/**** TestUtils ************************************************************/
+/**** HostRuntime **********************************************************/
 
+/* All threads share the Python interpreter, so no per-thread runtime is
+ * needed.
+ */
 void*
-cfish_TestUtils_clone_host_runtime() {
-    CFISH_THROW(CFISH_ERR, "TODO");
-    CFISH_UNREACHABLE_RETURN(void*);
+cfish_HostRuntime_clone() {
+    return NULL;
 }
 
 void
-cfish_TestUtils_set_host_runtime(void *runtime) {
+cfish_HostRuntime_set_current(void *runtime) {
     CFISH_UNUSED_VAR(runtime);
-    CFISH_THROW(CFISH_ERR, "TODO");
 }
 
 void
-cfish_TestUtils_destroy_host_runtime(void *runtime) {
+cfish_HostRuntime_destroy(void *runtime) {
     CFISH_UNUSED_VAR(runtime);
-    CFISH_THROW(CFISH_ERR, "TODO");
 }
 
 /**** To_Host methods ******************************************************/
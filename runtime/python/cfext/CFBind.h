@@ -113,7 +113,8 @@ CFBind_py_to_cfish_noinc(PyObject *py_obj, cfish_Class *klass,
                          void *allocation);
 
 /** Associate Clownfish classes with Python type objects.  (Internal-only,
-  * used during bootstrapping.)
+  * used during bootstrapping.)  The arrays are not copied and must stay
+  * valid for the lifetime of the process.
   */
 void
 CFBind_assoc_py_types(struct cfish_Class ***klass_handles,
@@ -219,6 +220,40 @@ CFBind_maybe_convert_float(PyObject *input, float *ptr);
 int
 CFBind_maybe_convert_double(PyObject *input, double *ptr);
 
+/** The signature shared by the conversion routines above.
+  */
+typedef int (*CFBindConverter)(PyObject *input, void *ptr);
+
+/* Method wrappers use the vectorcall protocol where it is available and fall
+ * back to PyArg_ParseTupleAndKeywords otherwise.
+ */
+#if PY_VERSION_HEX >= 0x03070000
+  #define CFBIND_HAS_FASTCALL
+  #define CFBIND_METH_KEYWORDS (METH_FASTCALL|METH_KEYWORDS)
+#else
+  #define CFBIND_METH_KEYWORDS (METH_KEYWORDS|METH_VARARGS)
+#endif
+
+/** Parse the args of a METH_FASTCALL|METH_KEYWORDS function and convert them
+  * with the routines above.  This replaces PyArg_ParseTupleAndKeywords in
+  * generated method wrappers.
+  *
+  * @param keywords The names of the `num_params` params.
+  * @param py_keywords A static array of `num_params` slots where the
+  * interned `keywords` are cached.
+  * @param num_required The number of leading params without default value.
+  * @param converters The conversion routine of each param.
+  * @param targets The argument passed to each conversion routine.
+  * @param values Scratch space for `num_params` items.
+  * @return true on success, false if an exception was raised.
+  */
+int
+CFBind_parse_fastcall(PyObject *const *args, Py_ssize_t nargs,
+                      PyObject *kwnames, const char **keywords,
+                      PyObject **py_keywords, Py_ssize_t num_params,
+                      Py_ssize_t num_required, CFBindConverter *converters,
+                      void **targets, PyObject **values);
+
 void
 CFBind_class_bootstrap_hook1(struct cfish_Class *self);
 
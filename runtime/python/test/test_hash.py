@@ -27,6 +27,21 @@ class TestHash(unittest.TestCase):
         h.store("nada", None)
         self.assertEqual(h.fetch("nada"), None)
 
+    def testKeywordArgs(self):
+        h = clownfish.Hash()
+        h.store(key="foo", value="bar")
+        h.store("baz", value="qux")
+        self.assertEqual(h.fetch(key="foo"), "bar")
+        self.assertEqual(h.fetch("baz"), "qux")
+        with self.assertRaises(TypeError):
+            h.store("foo")
+        with self.assertRaises(TypeError):
+            h.store("foo", "bar", "baz")
+        with self.assertRaises(TypeError):
+            h.store("foo", key="foo", value="bar")
+        with self.assertRaises(TypeError):
+            h.fetch(nope="foo")
+
     def testDelete(self):
         h = clownfish.Hash()
         h.store("foo", "bar")
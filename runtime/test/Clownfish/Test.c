@@ -34,11 +34,16 @@
 #include "Clownfish/Test/TestLockFreeRegistry.h"
 #include "Clownfish/Test/TestMethod.h"
 #include "Clownfish/Test/TestNum.h"
+#include "Clownfish/Test/TestNumArray.h"
 #include "Clownfish/Test/TestObj.h"
 #include "Clownfish/Test/TestPtrHash.h"
 #include "Clownfish/Test/TestVector.h"
 #include "Clownfish/Test/Util/TestAtomic.h"
 #include "Clownfish/Test/Util/TestMemory.h"
+#include "Clownfish/Test/Util/TestMPMCQueue.h"
+#include "Clownfish/Test/Util/TestSPSCRing.h"
+#include "Clownfish/Test/Util/TestThreadPool.h"
+#include "Clownfish/Test/Util/TestTopK.h"
 
 TestSuite*
 Test_create_test_suite() {
@@ -57,10 +62,15 @@ Test_create_test_suite() {
     TestSuite_Add_Batch(suite, (TestBatch*)TestCB_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestBoolean_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestNum_new());
+    TestSuite_Add_Batch(suite, (TestBatch*)TestNumArray_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestAtomic_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestLFReg_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestMemory_new());
     TestSuite_Add_Batch(suite, (TestBatch*)TestPtrHash_new());
+    TestSuite_Add_Batch(suite, (TestBatch*)TestTopK_new());
+    TestSuite_Add_Batch(suite, (TestBatch*)TestMPMCQueue_new());
+    TestSuite_Add_Batch(suite, (TestBatch*)TestSPSCRing_new());
+    TestSuite_Add_Batch(suite, (TestBatch*)TestThreadPool_new());
 
     return suite;
 }
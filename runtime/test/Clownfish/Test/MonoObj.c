@@ -0,0 +1,61 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define C_TESTCFISH_MONOOBJ
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Test/MonoObj.h"
+#include "Clownfish/Class.h"
+
+MonoObj*
+MonoObj_new(int32_t value) {
+    MonoObj *self = (MonoObj*)Class_Make_Obj(MONOOBJ);
+    return MonoObj_init(self, value);
+}
+
+MonoObj*
+MonoObj_init(MonoObj *self, int32_t value) {
+    MonoObj_IVARS(self)->value = value;
+    return self;
+}
+
+int32_t
+MonoObj_Get_Value_IMP(MonoObj *self) {
+    return MonoObj_IVARS(self)->value;
+}
+
+void
+MonoObj_Set_Value_IMP(MonoObj *self, int32_t value) {
+    MonoObj_IVARS(self)->value = value;
+}
+
+int32_t
+MonoObj_Get_Value_Virtual_IMP(MonoObj *self) {
+    return MonoObj_IVARS(self)->value;
+}
+
+MonoObjSub*
+MonoObjSub_new(int32_t value) {
+    MonoObjSub *self = (MonoObjSub*)Class_Make_Obj(MONOOBJSUB);
+    return (MonoObjSub*)MonoObj_init((MonoObj*)self, value);
+}
+
+int32_t
+MonoObjSub_Get_Value_IMP(MonoObjSub *self) {
+    return -MonoObj_IVARS((MonoObj*)self)->value;
+}
+
@@ -24,10 +24,15 @@
 #include "Clownfish/TestHarness/TestBatchRunner.h"
 #include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/String.h"
 #include "Clownfish/Util/Memory.h"
 
+#include <stdio.h>
 #include <string.h>
 
+#define MMAP_TEST_FILE "_test_blob_mmap.tmp"
+
 TestBlob*
 TestBlob_new() {
     return (TestBlob*)Class_Make_Obj(TESTBLOB);
@@ -134,14 +139,119 @@ test_Compare_To(TestBatchRunner *runner) {
     }
 }
 
+static void
+test_Slice(TestBatchRunner *runner) {
+    Blob *blob = Blob_new("0123456789", 10);
+
+    {
+        Blob *slice = Blob_Slice(blob, 2, 3);
+        TEST_TRUE(runner, Blob_Equals_Bytes(slice, "234", 3), "Slice");
+        TEST_TRUE(runner, Blob_Get_Buf(slice) == Blob_Get_Buf(blob) + 2,
+                  "Slice shares buffer");
+        Blob *inner = Blob_Slice(slice, 1, 100);
+        TEST_TRUE(runner, Blob_Equals_Bytes(inner, "34", 2),
+                  "Slice of slice truncates length");
+        TEST_TRUE(runner, Blob_Get_Buf(inner) == Blob_Get_Buf(blob) + 3,
+                  "Slice of slice shares buffer");
+        DECREF(slice);
+        DECREF(blob);
+        TEST_TRUE(runner, Blob_Equals_Bytes(inner, "34", 2),
+                  "Slice outlives original");
+        DECREF(inner);
+    }
+
+    {
+        static const char buf[] = "wrapped";
+        Blob *wrapped = Blob_new_wrap(buf, 7);
+        Blob *slice = Blob_Slice(wrapped, 0, 4);
+        TEST_TRUE(runner, Blob_Equals_Bytes(slice, "wrap", 4),
+                  "Slice of wrapped Blob");
+        TEST_TRUE(runner, Blob_Get_Buf(slice) != buf,
+                  "Slice of wrapped Blob copies");
+        Blob *empty = Blob_Slice(wrapped, 8, 1);
+        TEST_UINT_EQ(runner, Blob_Get_Size(empty), 0,
+                     "Slice with offset past end is empty");
+        DECREF(empty);
+        DECREF(slice);
+        DECREF(wrapped);
+    }
+}
+
+static void
+S_mmap_out_of_range(void *context) {
+    String *path = (String*)context;
+    Blob *blob = Blob_new_mmap(path, 5000, 10, MMAP_NORMAL);
+    DECREF(blob);
+}
+
+static void
+S_mmap_whole_file(void *context) {
+    String *path = (String*)context;
+    Blob *blob = Blob_new_mmap(path, 0, -1, MMAP_NORMAL);
+    DECREF(blob);
+}
+
+static void
+test_new_mmap(TestBatchRunner *runner) {
+    // Write a file which spans several pages.
+    FILE *file = fopen(MMAP_TEST_FILE, "wb");
+    if (!file) {
+        SKIP(runner, 7, "Can't write " MMAP_TEST_FILE);
+        return;
+    }
+    for (int i = 0; i < 5000; i++) {
+        fputc('a' + i % 26, file);
+    }
+    fclose(file);
+
+    String *path = Str_newf(MMAP_TEST_FILE);
+
+    Blob *blob = Blob_new_mmap(path, 0, -1, MMAP_SEQUENTIAL);
+    TEST_UINT_EQ(runner, Blob_Get_Size(blob), 5000,
+                 "new_mmap maps whole file");
+    TEST_TRUE(runner, memcmp(Blob_Get_Buf(blob) + 26, "abcd", 4) == 0,
+              "new_mmap content");
+    Blob *slice = Blob_Slice(blob, 4114, 3);
+    DECREF(blob);
+    TEST_TRUE(runner, Blob_Equals_Bytes(slice, "ghi", 3),
+              "Slice of mapped Blob outlives original");
+    DECREF(slice);
+
+    // Unaligned offset.
+    blob = Blob_new_mmap(path, 4100, 3, MMAP_RANDOM);
+    TEST_TRUE(runner, Blob_Equals_Bytes(blob, "stu", 3),
+              "new_mmap with unaligned offset");
+    DECREF(blob);
+
+    blob = Blob_new_mmap(path, 5000, -1, MMAP_NORMAL);
+    TEST_UINT_EQ(runner, Blob_Get_Size(blob), 0,
+                 "new_mmap of empty region");
+    DECREF(blob);
+
+    Err *error = Err_trap(S_mmap_out_of_range, path);
+    TEST_TRUE(runner, error != NULL, "new_mmap past end of file throws");
+    DECREF(error);
+
+    DECREF(path);
+    remove(MMAP_TEST_FILE);
+
+    path = Str_newf("_no_such_file.tmp");
+    error = Err_trap(S_mmap_whole_file, path);
+    TEST_TRUE(runner, error != NULL, "new_mmap of missing file throws");
+    DECREF(error);
+    DECREF(path);
+}
+
 void
 TestBlob_Run_IMP(TestBlob *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 17);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 32);
     test_new_steal(runner);
     test_new_wrap(runner);
     test_Equals(runner);
     test_Clone(runner);
     test_Compare_To(runner);
+    test_Slice(runner);
+    test_new_mmap(runner);
 }
 
 
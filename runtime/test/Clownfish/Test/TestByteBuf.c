@@ -201,9 +201,73 @@ test_Yield_Blob(TestBatchRunner *runner) {
     DECREF(bb);
 }
 
+static void
+test_View(TestBatchRunner *runner) {
+    ByteBuf *bb = BB_new_bytes("0123456789", 10);
+
+    Blob *view = BB_View(bb, 4, 3);
+    TEST_TRUE(runner, Blob_Equals_Bytes(view, "456", 3), "View");
+    TEST_TRUE(runner, Blob_Get_Buf(view) == BB_Get_Buf(bb) + 4,
+              "View shares buffer");
+
+    Blob *tail = BB_View(bb, 8, 100);
+    TEST_TRUE(runner, Blob_Equals_Bytes(tail, "89", 2),
+              "View truncates length");
+    DECREF(tail);
+
+    BB_Grow(bb, 1000);
+    BB_Cat_Bytes(bb, "abc", 3);
+    TEST_TRUE(runner, BB_Equals_Bytes(bb, "0123456789abc", 13),
+              "ByteBuf grows while view is alive");
+    TEST_TRUE(runner, Blob_Equals_Bytes(view, "456", 3),
+              "View survives reallocation");
+
+    Blob *second = BB_View(bb, 10, 3);
+    DECREF(bb);
+    TEST_TRUE(runner, Blob_Equals_Bytes(second, "abc", 3),
+              "View survives ByteBuf");
+    DECREF(second);
+    DECREF(view);
+
+    bb = BB_new_bytes("alpha", 5);
+    view = BB_View(bb, 1, 2);
+    Blob *blob = BB_Yield_Blob(bb);
+    TEST_TRUE(runner, Blob_Equals_Bytes(blob, "alpha", 5),
+              "Yield_Blob with view");
+    TEST_TRUE(runner, Blob_Equals_Bytes(view, "lp", 2),
+              "View survives Yield_Blob");
+    DECREF(blob);
+    DECREF(view);
+    DECREF(bb);
+
+    bb = BB_new_bytes("gamma", 5);
+    view = BB_View(bb, 0, 5);
+    BB_Set_Size(bb, 0);
+    BB_Cat_Bytes(bb, "delta", 5);
+    TEST_TRUE(runner, BB_Equals_Bytes(bb, "delta", 5),
+              "Cat after View and Set_Size");
+    TEST_TRUE(runner, Blob_Equals_Bytes(view, "gamma", 5),
+              "View unchanged by in-place Cat");
+    DECREF(view);
+    view = BB_View(bb, 0, 5);
+    char *buf = BB_Grow(bb, 5);
+    buf[0] = 'D';
+    TEST_TRUE(runner, Blob_Equals_Bytes(view, "delta", 5),
+              "View unchanged by write after Grow");
+    DECREF(view);
+    DECREF(bb);
+
+    bb = BB_new_bytes("beta", 4);
+    DECREF(BB_View(bb, 0, 4));
+    BB_Cat_Bytes(bb, "maxwell", 7);
+    TEST_TRUE(runner, BB_Equals_Bytes(bb, "betamaxwell", 11),
+              "Grow after views are gone");
+    DECREF(bb);
+}
+
 void
 TestBB_Run_IMP(TestByteBuf *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 27);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 39);
     test_new_steal_bytes(runner);
     test_Equals(runner);
     test_Grow(runner);
@@ -213,6 +277,7 @@ TestBB_Run_IMP(TestByteBuf *self, TestBatchRunner *runner) {
     test_Utf8_To_String(runner);
     test_Set_Size(runner);
     test_Yield_Blob(runner);
+    test_View(runner);
 }
 
 
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "Clownfish/Test/TestClass.h"
+#include "Clownfish/Test/MonoObj.h"
 
 #include "Clownfish/Boolean.h"
 #include "Clownfish/Class.h"
@@ -153,12 +154,33 @@ test_Get_Methods(TestBatchRunner *runner) {
     DECREF(methods);
 }
 
+static void
+test_monomorphic_methods(TestBatchRunner *runner) {
+    MonoObj    *mono = MonoObj_new(42);
+    MonoObjSub *sub  = MonoObjSub_new(42);
+
+    TEST_INT_EQ(runner, MonoObj_Get_Value(mono), 42,
+                "monomorphic method, expected class");
+    MonoObj_Set_Value(mono, 7);
+    TEST_INT_EQ(runner, MonoObj_Get_Value(mono), 7,
+                "monomorphic void method, expected class");
+    TEST_INT_EQ(runner, MonoObj_Get_Value((MonoObj*)sub), -42,
+                "monomorphic method falls back to vtable for subclass");
+    MonoObj_Set_Value((MonoObj*)sub, 7);
+    TEST_INT_EQ(runner, MonoObjSub_Get_Value(sub), -7,
+                "inherited monomorphic void method");
+
+    DECREF(sub);
+    DECREF(mono);
+}
+
 void
 TestClass_Run_IMP(TestClass *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 12);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 16);
     test_bootstrap_idempotence(runner);
     test_simple_subclass(runner);
     test_add_alias_to_registry(runner);
     test_Get_Methods(runner);
+    test_monomorphic_methods(runner);
 }
 
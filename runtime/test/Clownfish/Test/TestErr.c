@@ -19,6 +19,7 @@
 
 #include "Clownfish/Test/TestErr.h"
 
+#include "Clownfish/CharBuf.h"
 #include "Clownfish/String.h"
 #include "Clownfish/Err.h"
 #include "Clownfish/Test.h"
@@ -84,6 +85,76 @@ test_Add_Frame(TestBatchRunner *runner) {
     }
 }
 
+static void
+test_lazy_frames(TestBatchRunner *runner) {
+    {
+        Err *error = Err_new(Str_newf("alpha"));
+        CharBuf *buf = CB_new(0);
+        CB_Cat_Trusted_Utf8(buf, "alpha\n", 6);
+        for (int i = 0; i < ERR_MAX_FRAMES * 2 + 1; i++) {
+            Err_Add_Static_Frame(error, "source.c", i, "function");
+            CB_catf(buf, "\tfunction at source.c line %i32\n", (int32_t)i);
+        }
+        String *expected = CB_Yield_String(buf);
+        TEST_TRUE(runner, Str_Equals(Err_Get_Mess(error), (Obj*)expected),
+                  "Add_Static_Frame beyond inline frame capacity keeps order");
+        DECREF(expected);
+        DECREF(buf);
+        DECREF(error);
+    }
+
+    {
+        Err *error = Err_new(Str_newf("alpha"));
+        Err_Add_Static_Frame(error, "source.c", 1, "function");
+        Err_Cat_Mess(error, SSTR_WRAP_C("beta"));
+        Err_Add_Static_Frame(error, "source.c", 2, "function");
+        String *string = Err_To_String(error);
+        const char *expected = "alpha\n\tfunction at source.c line 1\n"
+                               "beta\n\tfunction at source.c line 2\n";
+        TEST_TRUE(runner,
+                  Str_Equals_Utf8(string, expected, strlen(expected)),
+                  "Cat_Mess after Add_Static_Frame");
+        DECREF(string);
+        DECREF(error);
+    }
+
+    {
+        Err *error = Err_new(Str_newf("alpha"));
+        Err_Add_Static_Frame(error, "source.c", 1, "function");
+        char file[] = "copied.c";
+        Err_Add_Frame(error, file, 2, NULL);
+        file[0] = 'X';
+        Err_Add_Static_Frame(error, "source.c", 3, "function");
+        String *mess = Err_Get_Mess(error);
+        const char *expected = "alpha\n\tfunction at source.c line 1\n"
+                               "\tat copied.c line 2\n"
+                               "\tfunction at source.c line 3\n";
+        TEST_TRUE(runner, Str_Equals_Utf8(mess, expected, strlen(expected)),
+                  "Add_Frame copies its arguments and keeps frame order");
+        DECREF(error);
+    }
+}
+
+static void
+test_capture_backtraces(TestBatchRunner *runner) {
+    if (!Err_capture_backtraces(true)) {
+        SKIP(runner, 2, "no native backtrace support");
+        return;
+    }
+
+    Err *error = Err_new(Str_newf("alpha"));
+    Err_capture_backtraces(false);
+    TEST_TRUE(runner, Str_Contains_Utf8(Err_Get_Mess(error),
+                                        "Native backtrace:\n", 18),
+              "capture_backtraces");
+    DECREF(error);
+
+    error = Err_new(Str_newf("alpha"));
+    TEST_TRUE(runner, Str_Equals_Utf8(Err_Get_Mess(error), "alpha", 5),
+              "capture_backtraces disabled");
+    DECREF(error);
+}
+
 static void
 S_rethrow(void *context) {
     Err *error = (Err*)context;
@@ -101,6 +172,47 @@ test_rethrow(TestBatchRunner *runner) {
     DECREF(error);
 }
 
+static bool
+S_try_succeed(void *context) {
+    int *count = (int*)context;
+    *count += 1;
+    return true;
+}
+
+static bool
+S_try_fail(void *context) {
+    UNUSED_VAR(context);
+    Err_set_error(Err_new(Str_newf("failed")));
+    return false;
+}
+
+static bool
+S_try_fail_without_error(void *context) {
+    UNUSED_VAR(context);
+    return false;
+}
+
+static void
+test_attempt(TestBatchRunner *runner) {
+    int count = 0;
+    Err *error = Err_attempt(S_try_succeed, &count);
+    TEST_TRUE(runner, error == NULL && count == 1,
+              "attempt returns NULL on success");
+
+    error = Err_attempt(S_try_fail, NULL);
+    TEST_TRUE(runner, error != NULL
+                      && Str_Equals_Utf8(Err_Get_Mess(error), "failed", 6),
+              "attempt returns error on failure");
+    TEST_TRUE(runner, Err_get_error() == NULL,
+              "attempt clears global error");
+    DECREF(error);
+
+    error = Err_attempt(S_try_fail_without_error, NULL);
+    TEST_TRUE(runner, error != NULL && Obj_is_a((Obj*)error, ERR),
+              "attempt creates error if routine didn't set one");
+    DECREF(error);
+}
+
 static void
 S_err_thread(void *arg) {
     TestBatchRunner *runner = (TestBatchRunner*)arg;
@@ -135,11 +247,14 @@ test_threads(TestBatchRunner *runner) {
 
 void
 TestErr_Run_IMP(TestErr *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 9);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 18);
     test_To_String(runner);
     test_Cat_Mess(runner);
     test_Add_Frame(runner);
+    test_lazy_frames(runner);
+    test_capture_backtraces(runner);
     test_rethrow(runner);
+    test_attempt(runner);
     test_threads(runner);
 }
 
@@ -146,4 +146,15 @@ TestHost_Invoke_Aliased_From_C_IMP(TestHost *self) {
     return TestHost_Aliased(self);
 }
 
+int32_t
+TestHost_Fast_Callback_IMP(TestHost *self, int32_t a, int32_t b) {
+    UNUSED_VAR(self);
+    return a + b;
+}
+
+int32_t
+TestHost_Invoke_Fast_Callback_From_C_IMP(TestHost *self, int32_t a,
+                                         int32_t b) {
+    return TestHost_Fast_Callback(self, a, b);
+}
 
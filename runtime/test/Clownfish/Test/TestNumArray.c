@@ -0,0 +1,194 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#define C_CFISH_NUMARRAY
+#define C_CFISH_I32ARRAY
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Test/TestNumArray.h"
+
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/NumArray.h"
+#include "Clownfish/Test.h"
+#include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Memory.h"
+
+TestNumArray*
+TestNumArray_new() {
+    return (TestNumArray*)Class_Make_Obj(TESTNUMARRAY);
+}
+
+static void
+S_fetch_out_of_bounds(void *context) {
+    I32Array *array = (I32Array*)context;
+    I32Arr_Fetch(array, I32Arr_Get_Size(array));
+}
+
+static void
+S_push_past_capacity(void *context) {
+    I32Array *array = (I32Array*)context;
+    for (size_t i = I32Arr_Get_Size(array); i <= array->cap; i++) {
+        I32Arr_Push(array, 0);
+    }
+}
+
+static void
+S_min_of_empty(void *context) {
+    I64Array *array = (I64Array*)context;
+    I64Arr_Min(array);
+}
+
+static void
+test_I32Array(TestBatchRunner *runner) {
+    I32Array *array = I32Arr_new(0);
+
+    for (int32_t i = 0; i < 100; i++) {
+        I32Arr_Push(array, 99 - i);
+    }
+    TEST_UINT_EQ(runner, I32Arr_Get_Size(array), 100, "Push updates size");
+    TEST_INT_EQ(runner, I32Arr_Fetch(array, 0), 99, "Fetch");
+    TEST_INT_EQ(runner, I32Arr_Get_Ptr(array)[99], 0, "Get_Ptr");
+
+    I32Arr_Store(array, 102, 7);
+    TEST_UINT_EQ(runner, I32Arr_Get_Size(array), 103, "Store grows");
+    TEST_TRUE(runner,
+              I32Arr_Fetch(array, 100) == 0 && I32Arr_Fetch(array, 101) == 0,
+              "Store zero-fills gap");
+    I32Arr_Resize(array, 100);
+
+    TEST_INT_EQ(runner, I32Arr_Sum(array), 4950, "Sum");
+    TEST_INT_EQ(runner, I32Arr_Min(array), 0, "Min");
+    TEST_INT_EQ(runner, I32Arr_Max(array), 99, "Max");
+
+    I32Arr_Sort(array);
+    bool sorted = true;
+    for (size_t i = 0; i < 100; i++) {
+        if (I32Arr_Fetch(array, i) != (int32_t)i) { sorted = false; }
+    }
+    TEST_TRUE(runner, sorted, "Sort");
+
+    I32Array *slice = I32Arr_Slice(array, 95, 10);
+    TEST_UINT_EQ(runner, I32Arr_Get_Size(slice), 5, "Slice truncates");
+    TEST_INT_EQ(runner, I32Arr_Fetch(slice, 0), 95, "Slice offset");
+
+    I32Arr_Scale(slice, -2);
+    TEST_INT_EQ(runner, I32Arr_Fetch(slice, 4), -198, "Scale");
+
+    I32Array *twin = I32Arr_Clone(array);
+    TEST_TRUE(runner, I32Arr_Equals(array, (Obj*)twin), "Clone and Equals");
+    I32Arr_Store(twin, 0, 1);
+    TEST_FALSE(runner, I32Arr_Equals(array, (Obj*)twin),
+               "Equals detects different values");
+
+    Err *error = Err_trap(S_fetch_out_of_bounds, array);
+    TEST_TRUE(runner, error != NULL, "Fetch out of bounds throws");
+    DECREF(error);
+
+    NumArr_add_export((NumArray*)array);
+    error = Err_trap(S_push_past_capacity, array);
+    TEST_TRUE(runner, error != NULL,
+              "Reallocation throws while buffer is exported");
+    DECREF(error);
+    NumArr_remove_export((NumArray*)array);
+
+    DECREF(twin);
+    DECREF(slice);
+    DECREF(array);
+}
+
+static void
+test_I64Array(TestBatchRunner *runner) {
+    int64_t nums[] = { INT64_C(5000000000), -3, INT64_C(-7000000000), 12 };
+    I64Array *array = I64Arr_new_from(nums, 4);
+
+    TEST_UINT_EQ(runner, I64Arr_Get_Size(array), 4, "new_from");
+    TEST_TRUE(runner, I64Arr_Sum(array) == INT64_C(-2000000000) + 9, "Sum");
+    TEST_TRUE(runner, I64Arr_Min(array) == INT64_C(-7000000000), "Min");
+    TEST_TRUE(runner, I64Arr_Max(array) == INT64_C(5000000000), "Max");
+
+    I64Arr_Sort(array);
+    TEST_TRUE(runner,
+              I64Arr_Fetch(array, 0) == INT64_C(-7000000000)
+              && I64Arr_Fetch(array, 3) == INT64_C(5000000000),
+              "Sort");
+
+    I64Array *empty = I64Arr_new(0);
+    Err *error = Err_trap(S_min_of_empty, empty);
+    TEST_TRUE(runner, error != NULL, "Min of empty array throws");
+    DECREF(error);
+
+    // Same bytes, different element type.
+    int32_t   halves[] = { 0, 0 };
+    I64Array *zero     = I64Arr_new(1);
+    I64Arr_Push(zero, 0);
+    I32Array *pair     = I32Arr_new_from(halves, 2);
+    TEST_FALSE(runner, I64Arr_Equals(zero, (Obj*)pair),
+               "Equals rejects other array types");
+
+    DECREF(pair);
+    DECREF(zero);
+    DECREF(empty);
+    DECREF(array);
+}
+
+static void
+test_F64Array(TestBatchRunner *runner) {
+    double   *nums  = TestUtils_random_f64s(NULL, 1001);
+    F64Array *array = F64Arr_new(0);
+    double    sum   = 0.0;
+    double    min   = 1.0;
+    double    max   = 0.0;
+
+    for (size_t i = 0; i < 1001; i++) {
+        F64Arr_Push(array, nums[i]);
+        sum += nums[i];
+        if (nums[i] < min) { min = nums[i]; }
+        if (nums[i] > max) { max = nums[i]; }
+    }
+    double diff = F64Arr_Sum(array) - sum;
+    TEST_TRUE(runner, diff < 1e-9 && diff > -1e-9, "Sum");
+    TEST_TRUE(runner, F64Arr_Min(array) == min, "Min");
+    TEST_TRUE(runner, F64Arr_Max(array) == max, "Max");
+
+    F64Arr_Scale(array, 2.0);
+    TEST_TRUE(runner, F64Arr_Max(array) == max * 2.0, "Scale");
+
+    F64Arr_Sort(array);
+    bool sorted = true;
+    for (size_t i = 1; i < 1001; i++) {
+        if (F64Arr_Fetch(array, i - 1) > F64Arr_Fetch(array, i)) {
+            sorted = false;
+        }
+    }
+    TEST_TRUE(runner, sorted, "Sort");
+
+    DECREF(array);
+    FREEMEM(nums);
+}
+
+void
+TestNumArray_Run_IMP(TestNumArray *self, TestBatchRunner *runner) {
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 28);
+    test_I32Array(runner);
+    test_I64Array(runner);
+    test_F64Array(runner);
+}
+
@@ -25,9 +25,15 @@
 
 #include "Clownfish/String.h"
 #include "Clownfish/Err.h"
+#include "Clownfish/Hash.h"
 #include "Clownfish/Test.h"
 #include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Class.h"
+#include "Clownfish/Vector.h"
+
+#define NUM_SHARE_THREADS 4
+#define NUM_SHARE_ITERS   100000
 
 TestObj*
 TestObj_new() {
@@ -62,6 +68,80 @@ test_refcounts(TestBatchRunner *runner) {
     DECREF(obj);
 }
 
+typedef struct {
+    Vector   *vec;
+    uint64_t  target_time;
+} ShareArgs;
+
+static void
+S_incref_decref_many(void *varg) {
+    ShareArgs *args = (ShareArgs*)varg;
+    Vector *vec = args->vec;
+    Obj *elem = Vec_Fetch(vec, 0);
+
+    // Wait until all threads have been started.
+    while (TestUtils_time() < args->target_time) {
+        TestUtils_thread_yield();
+    }
+
+    for (int i = 0; i < NUM_SHARE_ITERS; i++) {
+        INCREF(vec);
+        INCREF(elem);
+        DECREF(elem);
+        DECREF(vec);
+    }
+}
+
+static void
+test_Share(TestBatchRunner *runner) {
+    Vector *vec  = Vec_new(2);
+    Hash   *hash = Hash_new(0);
+    Obj    *obj  = S_new_testobj();
+    Hash_Store_Utf8(hash, "obj", 3, INCREF(obj));
+    Vec_Push(vec, (Obj*)hash);
+    Vec_Push(vec, NULL);
+
+    Vec_Share(vec);
+    TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(obj), 2,
+                "Share doesn't change refcount");
+    INCREF(obj);
+    TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(obj), 3, "INCREF shared object");
+    DECREF(obj);
+    TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(obj), 2, "DECREF shared object");
+    TEST_FALSE(runner, Obj_make_shared(obj),
+               "Share reaches objects nested in containers");
+
+    Obj *probe = S_new_testobj();
+    bool atomic_refcounts = Obj_make_shared(probe);
+    DECREF(probe);
+
+    if (!TestUtils_has_threads || !atomic_refcounts) {
+        // Either no threads or the host handles refcounts itself.
+        SKIP(runner, 2, "No atomic refcounts");
+    }
+    else {
+        ShareArgs args;
+        args.vec         = vec;
+        args.target_time = TestUtils_time() + 100 * 1000;
+
+        Thread *threads[NUM_SHARE_THREADS];
+        for (int i = 0; i < NUM_SHARE_THREADS; i++) {
+            threads[i] = TestUtils_thread_create(S_incref_decref_many, &args,
+                                                 NULL);
+        }
+        for (int i = 0; i < NUM_SHARE_THREADS; i++) {
+            TestUtils_thread_join(threads[i]);
+        }
+        TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(vec), 1,
+                    "Concurrent refcounting of shared Vector");
+        TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(hash), 1,
+                    "Concurrent refcounting of shared element");
+    }
+
+    DECREF(vec);
+    DECREF(obj);
+}
+
 static void
 test_To_String(TestBatchRunner *runner) {
     Obj *testobj = S_new_testobj();
@@ -187,7 +267,7 @@ test_abstract_routines(TestBatchRunner *runner) {
 
 void
 TestObj_Run_IMP(TestObj *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 20);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 26);
     test_refcounts(runner);
     test_To_String(runner);
     test_Equals(runner);
@@ -195,5 +275,6 @@ TestObj_Run_IMP(TestObj *self, TestBatchRunner *runner) {
     test_downcast(runner);
     test_certify(runner);
     test_abstract_routines(runner);
+    test_Share(runner);
 }
 
@@ -23,6 +23,7 @@
 #include "Clownfish/Test/TestString.h"
 
 #include "Clownfish/String.h"
+#include "Clownfish/Blob.h"
 #include "Clownfish/Boolean.h"
 #include "Clownfish/ByteBuf.h"
 #include "Clownfish/CharBuf.h"
@@ -33,6 +34,10 @@
 #include "Clownfish/Util/Memory.h"
 #include "Clownfish/Class.h"
 
+#include <stdio.h>
+
+#define MMAP_TEST_FILE "_test_string_mmap.tmp"
+
 #define SMILEY "\xE2\x98\xBA"
 static char smiley[] = { (char)0xE2, (char)0x98, (char)0xBA, 0 };
 static uint32_t smiley_len = 3;
@@ -1098,9 +1103,53 @@ test_iterator_substring(TestBatchRunner *runner) {
     DECREF(string);
 }
 
+static void
+S_mmap_invalid_utf8(void *context) {
+    String *path = (String*)context;
+    String *string = Str_new_mmap_utf8(path, 0, -1, MMAP_NORMAL);
+    DECREF(string);
+}
+
+static void
+test_new_mmap(TestBatchRunner *runner) {
+    FILE *file = fopen(MMAP_TEST_FILE, "wb");
+    if (!file) {
+        SKIP(runner, 5, "Can't write " MMAP_TEST_FILE);
+        return;
+    }
+    fputs("a\xE2\x98\x95" "b\xFF", file);
+    fclose(file);
+
+    String *path = Str_newf(MMAP_TEST_FILE);
+
+    String *string = Str_new_mmap_utf8(path, 0, 5, MMAP_SEQUENTIAL);
+    TEST_TRUE(runner, Str_Equals_Utf8(string, "a\xE2\x98\x95" "b", 5),
+              "new_mmap_utf8");
+    String *substring = Str_SubString(string, 1, 1);
+    DECREF(string);
+    TEST_TRUE(runner, Str_Equals_Utf8(substring, "\xE2\x98\x95", 3),
+              "SubString of mapped String outlives original");
+    DECREF(substring);
+
+    Err *error = Err_trap(S_mmap_invalid_utf8, path);
+    TEST_TRUE(runner, error != NULL, "new_mmap_utf8 validates");
+    DECREF(error);
+
+    string = Str_new_mmap_trusted_utf8(path, 0, -1, MMAP_NORMAL);
+    TEST_UINT_EQ(runner, Str_Get_Size(string), 6,
+                 "new_mmap_trusted_utf8 skips validation");
+    TEST_FALSE(runner, Str_utf8_valid(Str_Get_Ptr8(string),
+                                      Str_Get_Size(string)),
+               "mapped String can be validated on demand");
+    DECREF(string);
+
+    DECREF(path);
+    remove(MMAP_TEST_FILE);
+}
+
 void
 TestStr_Run_IMP(TestString *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 200);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 205);
     test_all_code_points(runner);
     test_utf8_valid(runner);
     test_validate_utf8(runner);
@@ -1127,6 +1176,7 @@ TestStr_Run_IMP(TestString *self, TestBatchRunner *runner) {
     test_iterator(runner);
     test_iterator_whitespace(runner);
     test_iterator_substring(runner);
+    test_new_mmap(runner);
 }
 
 /*************************** StringCallbackTest ***************************/
@@ -26,6 +26,7 @@
 #include "Clownfish/Test/TestVector.h"
 
 #include "Clownfish/String.h"
+#include "Clownfish/Blob.h"
 #include "Clownfish/Boolean.h"
 #include "Clownfish/Err.h"
 #include "Clownfish/Num.h"
@@ -34,6 +35,7 @@
 #include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Vector.h"
 #include "Clownfish/Class.h"
+#include "Clownfish/Util/Memory.h"
 
 TestVector*
 TestVector_new() {
@@ -527,6 +529,228 @@ test_Sort(TestBatchRunner *runner) {
     DECREF(wanted);
 }
 
+static int
+S_reverse_compare(void *context, const void *va, const void *vb) {
+    Obj *a = *(Obj**)va;
+    Obj *b = *(Obj**)vb;
+    int *count = (int*)context;
+    (*count)++;
+    return Obj_Compare_To(b, a);
+}
+
+static void
+test_Sort_With(TestBatchRunner *runner) {
+    Vector *array  = Vec_new(8);
+    Vector *wanted = Vec_new(8);
+    int     count  = 0;
+
+    Vec_Push(array, (Obj*)Str_newf("b"));
+    Vec_Push(array, (Obj*)Str_newf("c"));
+    Vec_Push(array, (Obj*)Str_newf("a"));
+
+    Vec_Push(wanted, (Obj*)Str_newf("c"));
+    Vec_Push(wanted, (Obj*)Str_newf("b"));
+    Vec_Push(wanted, (Obj*)Str_newf("a"));
+
+    Vec_Sort_With(array, S_reverse_compare, &count);
+    TEST_TRUE(runner, Vec_Equals(array, (Obj*)wanted),
+              "Sort_With custom compare");
+    TEST_TRUE(runner, count > 0, "Sort_With passes context");
+
+    DECREF(array);
+    DECREF(wanted);
+}
+
+static Obj*
+S_length_key(void *context, Obj *elem) {
+    int *count = (int*)context;
+    (*count)++;
+    return (Obj*)Int_new((int64_t)Str_Length((String*)elem));
+}
+
+static Obj*
+S_string_key(void *context, Obj *elem) {
+    UNUSED_VAR(context);
+    if (Str_Equals_Utf8((String*)elem, "none", 4)) { return NULL; }
+    return (Obj*)Str_Clone((String*)elem);
+}
+
+static Obj*
+S_blob_key(void *context, Obj *elem) {
+    UNUSED_VAR(context);
+    String *string = (String*)elem;
+    return (Obj*)Blob_new(Str_Get_Ptr8(string), Str_Get_Size(string));
+}
+
+static Obj*
+S_mixed_key(void *context, Obj *elem) {
+    UNUSED_VAR(context);
+    size_t length = Str_Length((String*)elem);
+    if (length % 2) { return (Obj*)Float_new((double)length); }
+    return (Obj*)Int_new((int64_t)length);
+}
+
+static Obj*
+S_throwing_key(void *context, Obj *elem) {
+    int *count = (int*)context;
+    if (++(*count) == 3) {
+        THROW(ERR, "Key failure");
+    }
+    return (Obj*)Str_Clone((String*)elem);
+}
+
+static void
+S_sort_by_throwing_key(void *context) {
+    int count = 0;
+    Vec_Sort_By_Key((Vector*)context, S_throwing_key, &count);
+}
+
+static void
+S_test_sort_by_key(TestBatchRunner *runner, Vec_Sort_Key_t key_func,
+                   const char **input, const char **wanted_strings,
+                   size_t size, const char *test_name) {
+    Vector *array  = Vec_new(size);
+    Vector *wanted = Vec_new(size);
+    int     count  = 0;
+    for (size_t i = 0; i < size; i++) {
+        Vec_Push(array, input[i] ? (Obj*)Str_newf("%s", input[i]) : NULL);
+        Vec_Push(wanted, wanted_strings[i]
+                         ? (Obj*)Str_newf("%s", wanted_strings[i])
+                         : NULL);
+    }
+    Vec_Sort_By_Key(array, key_func, &count);
+    TEST_TRUE(runner, Vec_Equals(array, (Obj*)wanted), test_name);
+    DECREF(wanted);
+    DECREF(array);
+}
+
+static void
+test_Sort_By_Key(TestBatchRunner *runner) {
+    {
+        const char *input[]  = { "ccc", NULL, "a", "bb", "dd", "e" };
+        const char *wanted[] = { "a", "e", "bb", "dd", "ccc", NULL };
+        S_test_sort_by_key(runner, S_length_key, input, wanted, 6,
+                           "Sort_By_Key with Integer keys is stable");
+    }
+    {
+        const char *input[]  = { "b", "none", "ab", NULL, "a", "" };
+        const char *wanted[] = { "", "a", "ab", "b", "none", NULL };
+        S_test_sort_by_key(runner, S_string_key, input, wanted, 6,
+                           "Sort_By_Key with String keys and NULL keys");
+    }
+    {
+        const char *input[]  = { "b", "ab", "a", "" };
+        const char *wanted[] = { "", "a", "ab", "b" };
+        S_test_sort_by_key(runner, S_blob_key, input, wanted, 4,
+                           "Sort_By_Key with Blob keys");
+    }
+    {
+        const char *input[]  = { "ccc", "a", "dddd", "bb" };
+        const char *wanted[] = { "a", "bb", "ccc", "dddd" };
+        S_test_sort_by_key(runner, S_mixed_key, input, wanted, 4,
+                           "Sort_By_Key with mixed keys");
+    }
+
+    Vector *array = Vec_new(100);
+    int     count = 0;
+    for (int i = 0; i < 100; i++) {
+        Vec_Push(array, (Obj*)Str_newf("%i32", (int32_t)i));
+    }
+    Vec_Sort_By_Key(array, S_length_key, &count);
+    TEST_INT_EQ(runner, count, 100, "Sort_By_Key computes key once per elem");
+
+    // Keys computed before the exception must not leak.
+    Vector *copy  = Vec_Clone(array);
+    Err    *error = Err_trap(S_sort_by_throwing_key, array);
+    TEST_TRUE(runner, error != NULL, "Sort_By_Key propagates key exceptions");
+    TEST_TRUE(runner, Vec_Equals(array, (Obj*)copy),
+              "Sort_By_Key leaves Vector unchanged after exception");
+    DECREF(error);
+    DECREF(copy);
+    DECREF(array);
+}
+
+static Vector*
+S_random_int_vector(size_t size, int64_t limit) {
+    int64_t *nums  = TestUtils_random_i64s(NULL, size, 0, limit);
+    Vector  *array = Vec_new(size);
+    for (size_t i = 0; i < size; i++) {
+        Vec_Push(array, (Obj*)Int_new(nums[i]));
+    }
+    FREEMEM(nums);
+    return array;
+}
+
+static void
+test_Partial_Sort(TestBatchRunner *runner) {
+    Vector *array  = S_random_int_vector(1000, 100);
+    Vector *wanted = Vec_Clone(array);
+    Vec_Sort(wanted);
+
+    Vec_Partial_Sort(array, 50);
+    Vector *head      = Vec_Slice(array, 0, 50);
+    Vector *head_want = Vec_Slice(wanted, 0, 50);
+    TEST_TRUE(runner, Vec_Equals(head, (Obj*)head_want),
+              "Partial_Sort sorts leading elements");
+    TEST_UINT_EQ(runner, Vec_Get_Size(array), 1000,
+                 "Partial_Sort preserves size");
+    DECREF(head_want);
+    DECREF(head);
+
+    Vec_Partial_Sort(array, 5000);
+    TEST_TRUE(runner, Vec_Equals(array, (Obj*)wanted),
+              "Partial_Sort with k greater than size sorts everything");
+
+    DECREF(wanted);
+    DECREF(array);
+
+    array = Vec_new(4);
+    Vec_Push(array, NULL);
+    Vec_Push(array, (Obj*)Str_newf("b"));
+    Vec_Push(array, NULL);
+    Vec_Push(array, (Obj*)Str_newf("a"));
+    Vec_Partial_Sort(array, 3);
+    TEST_TRUE(runner, Str_Equals_Utf8((String*)Vec_Fetch(array, 0), "a", 1)
+                      && Str_Equals_Utf8((String*)Vec_Fetch(array, 1), "b", 1)
+                      && Vec_Fetch(array, 2) == NULL,
+              "Partial_Sort with NULLs");
+    DECREF(array);
+}
+
+static void
+test_Select_Nth(TestBatchRunner *runner) {
+    Vector *array  = S_random_int_vector(1000, 50);
+    Vector *wanted = Vec_Clone(array);
+    Vec_Sort(wanted);
+
+    bool partitioned = true;
+    size_t ticks[] = { 0, 1, 499, 998, 999 };
+    for (size_t i = 0; i < sizeof(ticks) / sizeof(ticks[0]); i++) {
+        size_t nth  = ticks[i];
+        Obj   *elem = Vec_Select_Nth(array, nth);
+        if (!Obj_Equals(elem, Vec_Fetch(wanted, nth))) {
+            partitioned = false;
+        }
+        for (size_t j = 0; j < 1000; j++) {
+            int32_t comparison = Obj_Compare_To(Vec_Fetch(array, j), elem);
+            if ((j < nth && comparison > 0) || (j > nth && comparison < 0)) {
+                partitioned = false;
+            }
+        }
+    }
+    TEST_TRUE(runner, partitioned, "Select_Nth partitions around nth");
+
+    TEST_TRUE(runner, Vec_Select_Nth(array, 1000) == NULL,
+              "Select_Nth out of bounds returns NULL");
+
+    Vec_Sort(array);
+    TEST_TRUE(runner, Vec_Equals(array, (Obj*)wanted),
+              "Select_Nth preserves elements");
+
+    DECREF(wanted);
+    DECREF(array);
+}
+
 static void
 test_Grow(TestBatchRunner *runner) {
     Vector *array = Vec_new(500);
@@ -553,7 +777,7 @@ test_Grow(TestBatchRunner *runner) {
 
 void
 TestVector_Run_IMP(TestVector *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 62);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 78);
     test_Equals(runner);
     test_Store_Fetch(runner);
     test_Push_Pop_Insert(runner);
@@ -566,6 +790,10 @@ TestVector_Run_IMP(TestVector *self, TestBatchRunner *runner) {
     test_Clone(runner);
     test_exceptions(runner);
     test_Sort(runner);
+    test_Sort_With(runner);
+    test_Sort_By_Key(runner);
+    test_Partial_Sort(runner);
+    test_Select_Nth(runner);
     test_Grow(runner);
 }
 
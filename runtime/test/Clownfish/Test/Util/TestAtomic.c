@@ -17,13 +17,19 @@
 #define CFISH_USE_SHORT_NAMES
 #define TESTCFISH_USE_SHORT_NAMES
 
+#include "charmony.h"
+
 #include "Clownfish/Test/Util/TestAtomic.h"
 
 #include "Clownfish/Test.h"
 #include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
 #include "Clownfish/Util/Atomic.h"
 #include "Clownfish/Class.h"
 
+#define NUM_THREADS 4
+#define NUM_ITERS   100000
+
 TestAtomic*
 TestAtomic_new() {
     return (TestAtomic*)Class_Make_Obj(TESTATOMIC);
@@ -56,10 +62,136 @@ test_cas_ptr(TestBatchRunner *runner) {
     TEST_TRUE(runner, target == bar_pointer, "cas_ptr sets target");
 }
 
+static void
+test_cas_int(TestBatchRunner *runner) {
+    int32_t i32 = 5;
+    TEST_TRUE(runner, Atomic_cas_i32(&i32, 5, -7) && i32 == -7,
+              "cas_i32 succeeds");
+    TEST_TRUE(runner, !Atomic_cas_i32(&i32, 5, 9) && i32 == -7,
+              "cas_i32 fails when old_value doesn't match");
+
+    int64_t i64 = INT64_C(0x100000000);
+    TEST_TRUE(runner, Atomic_cas_i64(&i64, INT64_C(0x100000000), 3)
+                      && i64 == 3,
+              "cas_i64 succeeds");
+    TEST_TRUE(runner, !Atomic_cas_i64(&i64, 0, 9) && i64 == 3,
+              "cas_i64 fails when old_value doesn't match");
+}
+
+static void
+test_fetch_add_sub(TestBatchRunner *runner) {
+    int32_t i32 = 10;
+    TEST_INT_EQ(runner, Atomic_fetch_add_i32(&i32, 5), 10,
+                "fetch_add_i32 returns previous value");
+    TEST_INT_EQ(runner, i32, 15, "fetch_add_i32 adds");
+    TEST_INT_EQ(runner, Atomic_fetch_sub_i32(&i32, 20), 15,
+                "fetch_sub_i32 returns previous value");
+    TEST_INT_EQ(runner, i32, -5, "fetch_sub_i32 subtracts");
+
+    int64_t i64 = INT64_C(0xFFFFFFFF);
+    TEST_INT_EQ(runner, Atomic_fetch_add_i64(&i64, 1), INT64_C(0xFFFFFFFF),
+                "fetch_add_i64 returns previous value");
+    TEST_INT_EQ(runner, i64, INT64_C(0x100000000),
+                "fetch_add_i64 carries into upper word");
+    TEST_INT_EQ(runner, Atomic_fetch_sub_i64(&i64, 2), INT64_C(0x100000000),
+                "fetch_sub_i64 returns previous value");
+    TEST_INT_EQ(runner, i64, INT64_C(0xFFFFFFFE), "fetch_sub_i64 subtracts");
+}
+
+static void
+test_load_store(TestBatchRunner *runner) {
+    int32_t i32 = 0;
+    Atomic_store_release_i32(&i32, 42);
+    TEST_INT_EQ(runner, Atomic_load_acquire_i32(&i32), 42,
+                "store_release_i32 and load_acquire_i32");
+
+    int64_t i64 = 0;
+    Atomic_store_release_i64(&i64, INT64_C(-0x123456789));
+    TEST_INT_EQ(runner, Atomic_load_acquire_i64(&i64), INT64_C(-0x123456789),
+                "store_release_i64 and load_acquire_i64");
+
+    int   foo = 1;
+    void *ptr = NULL;
+    Atomic_store_release_ptr(&ptr, &foo);
+    TEST_TRUE(runner, Atomic_load_acquire_ptr(&ptr) == &foo,
+              "store_release_ptr and load_acquire_ptr");
+
+    // Only check that these compile and return.
+    Atomic_fence_acquire();
+    Atomic_fence_release();
+    Atomic_fence();
+    Atomic_pause();
+    PASS(runner, "fences and pause");
+}
+
+typedef struct {
+    int32_t  counter32;
+    int64_t  counter64;
+    int32_t  cas_counter;
+    int32_t  ready;
+} CounterArgs;
+
+static void
+S_count_many(void *varg) {
+    CounterArgs *args = (CounterArgs*)varg;
+
+    // Spin until the main thread releases all workers at once.
+    while (!Atomic_load_acquire_i32(&args->ready)) {
+        Atomic_pause();
+        TestUtils_thread_yield();
+    }
+
+    for (int i = 0; i < NUM_ITERS; i++) {
+        Atomic_fetch_add_i32(&args->counter32, 3);
+        Atomic_fetch_sub_i32(&args->counter32, 1);
+        Atomic_fetch_add_i64(&args->counter64, 1);
+
+        int32_t old_value;
+        do {
+            old_value = Atomic_load_acquire_i32(&args->cas_counter);
+        } while (!Atomic_cas_i32(&args->cas_counter, old_value,
+                                 old_value + 1));
+    }
+}
+
+static void
+test_threads(TestBatchRunner *runner) {
+    if (!TestUtils_has_threads) {
+        SKIP(runner, 3, "No thread support");
+        return;
+    }
+
+    CounterArgs args;
+    args.counter32   = 0;
+    args.counter64   = 0;
+    args.cas_counter = 0;
+    args.ready       = 0;
+
+    Thread *threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads[i] = TestUtils_thread_create(S_count_many, &args, NULL);
+    }
+    Atomic_store_release_i32(&args.ready, 1);
+    for (int i = 0; i < NUM_THREADS; i++) {
+        TestUtils_thread_join(threads[i]);
+    }
+
+    TEST_INT_EQ(runner, args.counter32, NUM_THREADS * NUM_ITERS * 2,
+                "Concurrent fetch_add_i32 and fetch_sub_i32");
+    TEST_INT_EQ(runner, args.counter64, NUM_THREADS * NUM_ITERS,
+                "Concurrent fetch_add_i64");
+    TEST_INT_EQ(runner, args.cas_counter, NUM_THREADS * NUM_ITERS,
+                "Concurrent cas_i32 loop");
+}
+
 void
 TestAtomic_Run_IMP(TestAtomic *self, TestBatchRunner *runner) {
-    TestBatchRunner_Plan(runner, (TestBatch*)self, 6);
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 25);
     test_cas_ptr(runner);
+    test_cas_int(runner);
+    test_fetch_add_sub(runner);
+    test_load_store(runner);
+    test_threads(runner);
 }
 
 
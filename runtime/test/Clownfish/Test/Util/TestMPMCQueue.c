@@ -0,0 +1,189 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Test/Util/TestMPMCQueue.h"
+
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Num.h"
+#include "Clownfish/Test.h"
+#include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/MPMCQueue.h"
+
+#define NUM_PRODUCERS  2
+#define NUM_CONSUMERS  2
+#define NUM_PER_THREAD 20000
+
+TestMPMCQueue*
+TestMPMCQueue_new() {
+    return (TestMPMCQueue*)Class_Make_Obj(TESTMPMCQUEUE);
+}
+
+static void
+S_push_null(void *context) {
+    MPMCQueue_Push((MPMCQueue*)context, NULL);
+}
+
+static void
+test_Push_and_Pop(TestBatchRunner *runner) {
+    MPMCQueue *queue = MPMCQueue_new(5);
+    TEST_UINT_EQ(runner, MPMCQueue_Get_Capacity(queue), 8,
+                 "capacity is rounded up to a power of two");
+    MPMCQueue *tiny = MPMCQueue_new(0);
+    TEST_UINT_EQ(runner, MPMCQueue_Get_Capacity(tiny), 2,
+                 "minimum capacity");
+    DECREF(tiny);
+
+    TEST_TRUE(runner, MPMCQueue_Pop(queue) == NULL,
+              "Pop on empty queue returns NULL");
+
+    bool pushed = true;
+    for (int32_t i = 0; i < 8; i++) {
+        pushed &= MPMCQueue_Push(queue, (Obj*)Int_new(i));
+    }
+    TEST_TRUE(runner, pushed, "Push up to capacity");
+
+    Integer *extra = Int_new(8);
+    TEST_FALSE(runner, MPMCQueue_Push(queue, (Obj*)extra),
+               "Push on full queue fails");
+    TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(extra), 1,
+                "caller keeps element rejected by Push");
+
+    bool in_order = true;
+    for (int32_t i = 0; i < 4; i++) {
+        Integer *elem = (Integer*)MPMCQueue_Pop(queue);
+        in_order &= elem != NULL && Int_Get_Value(elem) == i;
+        DECREF(elem);
+    }
+    TEST_TRUE(runner, in_order, "Pop returns elements in FIFO order");
+
+    // Wrap around a few times.
+    int64_t next_in  = 8;
+    int64_t next_out = 4;
+    for (int lap = 0; lap < 3 * 8; lap++) {
+        MPMCQueue_Push(queue, (Obj*)Int_new(next_in++));
+        Integer *elem = (Integer*)MPMCQueue_Pop(queue);
+        in_order &= elem != NULL && Int_Get_Value(elem) == next_out++;
+        DECREF(elem);
+    }
+    TEST_TRUE(runner, in_order, "FIFO order after wrapping around");
+
+    Err *error = Err_trap(S_push_null, queue);
+    TEST_TRUE(runner, error != NULL, "Push NULL throws");
+    DECREF(error);
+
+    // Remaining elements are released by Destroy.
+    DECREF(extra);
+    DECREF(queue);
+}
+
+typedef struct {
+    MPMCQueue *queue;
+    int32_t    ready;
+    int32_t    num_popped;
+    int64_t    sum;
+    int32_t    producer_id;
+} ThreadArgs;
+
+static void
+S_wait_until_ready(ThreadArgs *args) {
+    while (!Atomic_load_acquire_i32(&args->ready)) {
+        TestUtils_thread_yield();
+    }
+}
+
+static void
+S_produce(void *varg) {
+    ThreadArgs *args = (ThreadArgs*)varg;
+    int32_t id = Atomic_fetch_add_i32(&args->producer_id, 1);
+    S_wait_until_ready(args);
+
+    for (int32_t i = 0; i < NUM_PER_THREAD; i++) {
+        Obj *elem = (Obj*)Int_new(id * NUM_PER_THREAD + i);
+        while (!MPMCQueue_Push(args->queue, elem)) {
+            TestUtils_thread_yield();
+        }
+    }
+}
+
+static void
+S_consume(void *varg) {
+    ThreadArgs *args  = (ThreadArgs*)varg;
+    int32_t     total = NUM_PRODUCERS * NUM_PER_THREAD;
+    S_wait_until_ready(args);
+
+    while (Atomic_load_acquire_i32(&args->num_popped) < total) {
+        Integer *elem = (Integer*)MPMCQueue_Pop(args->queue);
+        if (elem == NULL) {
+            TestUtils_thread_yield();
+            continue;
+        }
+        Atomic_fetch_add_i64(&args->sum, Int_Get_Value(elem));
+        Atomic_fetch_add_i32(&args->num_popped, 1);
+        DECREF(elem);
+    }
+}
+
+static void
+test_threads(TestBatchRunner *runner) {
+    if (!TestUtils_has_threads) {
+        SKIP(runner, 3, "No thread support");
+        return;
+    }
+
+    ThreadArgs args;
+    args.queue       = MPMCQueue_new(64);
+    args.ready       = 0;
+    args.num_popped  = 0;
+    args.sum         = 0;
+    args.producer_id = 0;
+
+    Thread *threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    for (int i = 0; i < NUM_PRODUCERS; i++) {
+        threads[i] = TestUtils_thread_create(S_produce, &args, NULL);
+    }
+    for (int i = 0; i < NUM_CONSUMERS; i++) {
+        threads[NUM_PRODUCERS+i]
+            = TestUtils_thread_create(S_consume, &args, NULL);
+    }
+    Atomic_store_release_i32(&args.ready, 1);
+    for (int i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; i++) {
+        TestUtils_thread_join(threads[i]);
+    }
+
+    int64_t total = NUM_PRODUCERS * NUM_PER_THREAD;
+    TEST_INT_EQ(runner, args.num_popped, total,
+                "consumers pop every element");
+    TEST_INT_EQ(runner, args.sum, total * (total - 1) / 2,
+                "every element is popped exactly once");
+    TEST_TRUE(runner, MPMCQueue_Pop(args.queue) == NULL,
+              "queue is empty after concurrent use");
+
+    DECREF(args.queue);
+}
+
+void
+TestMPMCQueue_Run_IMP(TestMPMCQueue *self, TestBatchRunner *runner) {
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 12);
+    test_Push_and_Pop(runner);
+    test_threads(runner);
+}
+
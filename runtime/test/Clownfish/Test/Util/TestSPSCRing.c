@@ -0,0 +1,164 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Test/Util/TestSPSCRing.h"
+
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Num.h"
+#include "Clownfish/Test.h"
+#include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/SPSCRing.h"
+
+#define NUM_ELEMS 50000
+
+TestSPSCRing*
+TestSPSCRing_new() {
+    return (TestSPSCRing*)Class_Make_Obj(TESTSPSCRING);
+}
+
+static void
+S_push_null(void *context) {
+    SPSCRing_Push((SPSCRing*)context, NULL);
+}
+
+static void
+test_Push_and_Pop(TestBatchRunner *runner) {
+    SPSCRing *ring = SPSCRing_new(3);
+    TEST_UINT_EQ(runner, SPSCRing_Get_Capacity(ring), 4,
+                 "capacity is rounded up to a power of two");
+
+    TEST_TRUE(runner, SPSCRing_Pop(ring) == NULL,
+              "Pop on empty ring returns NULL");
+
+    bool pushed = true;
+    for (int32_t i = 0; i < 4; i++) {
+        pushed &= SPSCRing_Push(ring, (Obj*)Int_new(i));
+    }
+    TEST_TRUE(runner, pushed, "Push up to capacity");
+
+    Integer *extra = Int_new(4);
+    TEST_FALSE(runner, SPSCRing_Push(ring, (Obj*)extra),
+               "Push on full ring fails");
+    TEST_INT_EQ(runner, CFISH_REFCOUNT_NN(extra), 1,
+                "caller keeps element rejected by Push");
+
+    bool in_order = true;
+    for (int32_t i = 0; i < 2; i++) {
+        Integer *elem = (Integer*)SPSCRing_Pop(ring);
+        in_order &= elem != NULL && Int_Get_Value(elem) == i;
+        DECREF(elem);
+    }
+    TEST_TRUE(runner, in_order, "Pop returns elements in FIFO order");
+
+    TEST_TRUE(runner, SPSCRing_Push(ring, (Obj*)extra),
+              "Push succeeds after Pop");
+    int64_t next_in  = 5;
+    int64_t next_out = 2;
+    for (int lap = 0; lap < 3 * 4; lap++) {
+        SPSCRing_Push(ring, (Obj*)Int_new(next_in++));
+        Integer *elem = (Integer*)SPSCRing_Pop(ring);
+        in_order &= elem != NULL && Int_Get_Value(elem) == next_out++;
+        DECREF(elem);
+    }
+    TEST_TRUE(runner, in_order, "FIFO order after wrapping around");
+
+    Err *error = Err_trap(S_push_null, ring);
+    TEST_TRUE(runner, error != NULL, "Push NULL throws");
+    DECREF(error);
+
+    // Remaining elements are released by Destroy.
+    DECREF(ring);
+}
+
+typedef struct {
+    SPSCRing *ring;
+    int32_t   ready;
+    int32_t   num_out_of_order;
+} ThreadArgs;
+
+static void
+S_produce(void *varg) {
+    ThreadArgs *args = (ThreadArgs*)varg;
+    while (!Atomic_load_acquire_i32(&args->ready)) {
+        TestUtils_thread_yield();
+    }
+
+    for (int32_t i = 0; i < NUM_ELEMS; i++) {
+        Obj *elem = (Obj*)Int_new(i);
+        while (!SPSCRing_Push(args->ring, elem)) {
+            TestUtils_thread_yield();
+        }
+    }
+}
+
+static void
+S_consume(void *varg) {
+    ThreadArgs *args = (ThreadArgs*)varg;
+    while (!Atomic_load_acquire_i32(&args->ready)) {
+        TestUtils_thread_yield();
+    }
+
+    for (int32_t i = 0; i < NUM_ELEMS; i++) {
+        Integer *elem;
+        while (NULL == (elem = (Integer*)SPSCRing_Pop(args->ring))) {
+            TestUtils_thread_yield();
+        }
+        if (Int_Get_Value(elem) != i) {
+            args->num_out_of_order++;
+        }
+        DECREF(elem);
+    }
+}
+
+static void
+test_threads(TestBatchRunner *runner) {
+    if (!TestUtils_has_threads) {
+        SKIP(runner, 2, "No thread support");
+        return;
+    }
+
+    ThreadArgs args;
+    args.ring             = SPSCRing_new(64);
+    args.ready            = 0;
+    args.num_out_of_order = 0;
+
+    Thread *producer = TestUtils_thread_create(S_produce, &args, NULL);
+    Thread *consumer = TestUtils_thread_create(S_consume, &args, NULL);
+    Atomic_store_release_i32(&args.ready, 1);
+    TestUtils_thread_join(producer);
+    TestUtils_thread_join(consumer);
+
+    TEST_INT_EQ(runner, args.num_out_of_order, 0,
+                "consumer pops every element in order");
+    TEST_TRUE(runner, SPSCRing_Pop(args.ring) == NULL,
+              "ring is empty after concurrent use");
+
+    DECREF(args.ring);
+}
+
+void
+TestSPSCRing_Run_IMP(TestSPSCRing *self, TestBatchRunner *runner) {
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 11);
+    test_Push_and_Pop(runner);
+    test_threads(runner);
+}
+
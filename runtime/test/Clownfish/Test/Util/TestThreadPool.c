@@ -0,0 +1,236 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include <string.h>
+
+#include "Clownfish/Test/Util/TestThreadPool.h"
+
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/String.h"
+#include "Clownfish/Test.h"
+#include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Atomic.h"
+#include "Clownfish/Util/Future.h"
+#include "Clownfish/Util/Memory.h"
+#include "Clownfish/Util/ThreadPool.h"
+
+#define NUM_TASKS   100
+#define NUM_ELEMS   10000
+#define NUM_JOINERS 8
+
+TestThreadPool*
+TestThreadPool_new() {
+    return (TestThreadPool*)Class_Make_Obj(TESTTHREADPOOL);
+}
+
+static void
+S_increment(void *context) {
+    Atomic_fetch_add_i32((int32_t*)context, 1);
+}
+
+static void
+S_throw(void *context) {
+    THROW(ERR, "Task %s failed", (const char*)context);
+}
+
+static void
+S_join(void *context) {
+    Future_Join((Future*)context);
+}
+
+typedef struct {
+    Future  *future;
+    int32_t  num_ok;
+} JoinArgs;
+
+static void
+S_join_and_read(void *context) {
+    JoinArgs *args  = (JoinArgs*)context;
+    Err      *error = Err_trap(S_join, args->future);
+    if (error) {
+        String *mess = Err_To_String(error);
+        if (Str_Contains_Utf8(mess, "Task bar failed", 15)
+            && Str_Equals(mess, (Obj*)Err_Get_Mess(error))
+           ) {
+            Atomic_fetch_add_i32(&args->num_ok, 1);
+        }
+        DECREF(mess);
+        DECREF(error);
+    }
+}
+
+static void
+test_Submit(TestBatchRunner *runner, uint32_t num_threads) {
+    ThreadPool *pool    = ThreadPool_new(num_threads);
+    int32_t     counter = 0;
+
+    Future *futures[NUM_TASKS];
+    for (int i = 0; i < NUM_TASKS; i++) {
+        futures[i] = ThreadPool_Submit(pool, S_increment, &counter);
+    }
+    bool all_done = true;
+    for (int i = 0; i < NUM_TASKS; i++) {
+        Future_Join(futures[i]);
+        all_done &= Future_Is_Done(futures[i]);
+        DECREF(futures[i]);
+    }
+    TEST_TRUE(runner, all_done, "Join waits for task (%u32 threads)",
+              num_threads);
+    TEST_INT_EQ(runner, counter, NUM_TASKS,
+                "all tasks run (%u32 threads)", num_threads);
+
+    // Destroying a Future without joining it waits for the task.
+    Future *future = ThreadPool_Submit(pool, S_increment, &counter);
+    DECREF(future);
+    TEST_INT_EQ(runner, counter, NUM_TASKS + 1,
+                "Destroy waits for task (%u32 threads)", num_threads);
+
+    future = ThreadPool_Submit(pool, S_throw, "foo");
+    Err *error = Err_trap(S_join, future);
+    TEST_TRUE(runner, error != NULL
+                      && Str_Contains_Utf8(Err_Get_Mess(error),
+                                           "Task foo failed", 15),
+              "Join rethrows exception of task (%u32 threads)",
+              num_threads);
+    DECREF(error);
+    TEST_TRUE(runner, Future_Get_Error(future) != NULL,
+              "Get_Error (%u32 threads)", num_threads);
+    DECREF(future);
+
+    // Several tasks join the same failed Future and read its message.
+    JoinArgs join_args;
+    join_args.future = ThreadPool_Submit(pool, S_throw, "bar");
+    join_args.num_ok = 0;
+    Future *joiners[NUM_JOINERS];
+    for (int i = 0; i < NUM_JOINERS; i++) {
+        joiners[i] = ThreadPool_Submit(pool, S_join_and_read, &join_args);
+    }
+    for (int i = 0; i < NUM_JOINERS; i++) {
+        Future_Join(joiners[i]);
+        DECREF(joiners[i]);
+    }
+    TEST_INT_EQ(runner, join_args.num_ok, NUM_JOINERS,
+                "concurrent joiners share exception (%u32 threads)",
+                num_threads);
+    DECREF(join_args.future);
+
+    DECREF(pool);
+}
+
+typedef struct {
+    ThreadPool *pool;
+    int32_t    *counts;
+    int32_t     num_calls;
+    size_t      fail_at;
+} ForArgs;
+
+static void
+S_count(void *context, size_t begin, size_t end) {
+    ForArgs *args = (ForArgs*)context;
+    Atomic_fetch_add_i32(&args->num_calls, 1);
+    for (size_t i = begin; i < end; i++) {
+        if (i == args->fail_at) {
+            THROW(ERR, "Failed at %u64", (uint64_t)i);
+        }
+        Atomic_fetch_add_i32(&args->counts[i], 1);
+    }
+}
+
+static bool
+S_all_counted_once(ForArgs *args) {
+    for (size_t i = 0; i < NUM_ELEMS; i++) {
+        if (args->counts[i] != 1) { return false; }
+    }
+    return true;
+}
+
+static void
+S_parallel_for(void *context) {
+    ForArgs *args = (ForArgs*)context;
+    ThreadPool_Parallel_For(args->pool, NUM_ELEMS, 100, S_count, args);
+}
+
+static void
+S_nested_task(void *context) {
+    ForArgs *args = (ForArgs*)context;
+    ThreadPool_Parallel_For(args->pool, NUM_ELEMS, 500, S_count, args);
+}
+
+static void
+test_Parallel_For(TestBatchRunner *runner, uint32_t num_threads) {
+    ForArgs args;
+    args.pool      = ThreadPool_new(num_threads);
+    args.counts    = (int32_t*)CALLOCATE(NUM_ELEMS, sizeof(int32_t));
+    args.num_calls = 0;
+    args.fail_at   = SIZE_MAX;
+
+    ThreadPool_Parallel_For(args.pool, NUM_ELEMS, 100, S_count, &args);
+    TEST_TRUE(runner, S_all_counted_once(&args),
+              "Parallel_For visits every index once (%u32 threads)",
+              num_threads);
+    if (num_threads == 0) {
+        TEST_INT_EQ(runner, args.num_calls, 1,
+                    "Parallel_For without workers runs a single range");
+    }
+    else {
+        TEST_INT_EQ(runner, args.num_calls, NUM_ELEMS / 100,
+                    "Parallel_For splits range by grain (%u32 threads)",
+                    num_threads);
+    }
+
+    // Nested Parallel_For from inside tasks.
+    memset(args.counts, 0, NUM_ELEMS * sizeof(int32_t));
+    Future *future = ThreadPool_Submit(args.pool, S_nested_task, &args);
+    Future_Join(future);
+    DECREF(future);
+    TEST_TRUE(runner, S_all_counted_once(&args),
+              "nested Parallel_For (%u32 threads)", num_threads);
+
+    args.fail_at = 4321;
+    Err *error = Err_trap(S_parallel_for, &args);
+    TEST_TRUE(runner, error != NULL
+                      && Str_Contains_Utf8(Err_Get_Mess(error),
+                                           "Failed at 4321", 14),
+              "Parallel_For rethrows exception (%u32 threads)",
+              num_threads);
+    DECREF(error);
+
+    FREEMEM(args.counts);
+    DECREF(args.pool);
+}
+
+void
+TestThreadPool_Run_IMP(TestThreadPool *self, TestBatchRunner *runner) {
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 22);
+
+    TEST_TRUE(runner, ThreadPool_num_cpus() >= 1, "num_cpus");
+    uint32_t num_threads = TestUtils_has_threads ? 4 : 0;
+    ThreadPool *pool = ThreadPool_new(num_threads);
+    TEST_INT_EQ(runner, ThreadPool_Get_Num_Threads(pool), num_threads,
+                "Get_Num_Threads");
+    DECREF(pool);
+
+    test_Submit(runner, 0);
+    test_Submit(runner, num_threads);
+    test_Parallel_For(runner, 0);
+    test_Parallel_For(runner, num_threads);
+}
+
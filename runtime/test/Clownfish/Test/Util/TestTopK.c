@@ -0,0 +1,122 @@
+/* Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define CFISH_USE_SHORT_NAMES
+#define TESTCFISH_USE_SHORT_NAMES
+
+#include "Clownfish/Test/Util/TestTopK.h"
+
+#include "Clownfish/Class.h"
+#include "Clownfish/Err.h"
+#include "Clownfish/Num.h"
+#include "Clownfish/Test.h"
+#include "Clownfish/TestHarness/TestBatchRunner.h"
+#include "Clownfish/TestHarness/TestUtils.h"
+#include "Clownfish/Util/Memory.h"
+#include "Clownfish/Util/TopK.h"
+#include "Clownfish/Vector.h"
+
+TestTopK*
+TestTopK_new() {
+    return (TestTopK*)Class_Make_Obj(TESTTOPK);
+}
+
+static int
+S_ascending(void *context, const void *va, const void *vb) {
+    Obj *a = *(Obj**)va;
+    Obj *b = *(Obj**)vb;
+    UNUSED_VAR(context);
+    return Obj_Compare_To(a, b);
+}
+
+static int
+S_descending(void *context, const void *va, const void *vb) {
+    return S_ascending(context, vb, va);
+}
+
+static void
+test_Insert(TestBatchRunner *runner) {
+    TopK *top_k = TopK_new(3, S_ascending, NULL);
+
+    TEST_UINT_EQ(runner, TopK_Get_K(top_k), 3, "Get_K");
+    TEST_TRUE(runner, TopK_Peek(top_k) == NULL, "Peek empty collector");
+
+    TEST_TRUE(runner, TopK_Insert(top_k, (Obj*)Int_new(50)),
+              "Insert into empty collector");
+    TopK_Insert(top_k, (Obj*)Int_new(40));
+    TopK_Insert(top_k, (Obj*)Int_new(60));
+    TEST_UINT_EQ(runner, TopK_Get_Size(top_k), 3, "Get_Size");
+    TEST_INT_EQ(runner, Int_Get_Value((Integer*)TopK_Peek(top_k)), 60,
+                "Peek returns lowest-ranked element");
+
+    TEST_FALSE(runner, TopK_Insert(top_k, (Obj*)Int_new(70)),
+               "Insert rejects element when full");
+    TEST_TRUE(runner, TopK_Insert(top_k, (Obj*)Int_new(10)),
+              "Insert displaces lowest-ranked element");
+    TEST_INT_EQ(runner, Int_Get_Value((Integer*)TopK_Peek(top_k)), 50,
+                "Peek after displacement");
+
+    Vector *got = TopK_Pop_All(top_k);
+    TEST_UINT_EQ(runner, Vec_Get_Size(got), 3, "Pop_All returns k elems");
+    TEST_TRUE(runner,
+              Int_Get_Value((Integer*)Vec_Fetch(got, 0)) == 10
+              && Int_Get_Value((Integer*)Vec_Fetch(got, 1)) == 40
+              && Int_Get_Value((Integer*)Vec_Fetch(got, 2)) == 50,
+              "Pop_All returns sorted elements");
+    TEST_UINT_EQ(runner, TopK_Get_Size(top_k), 0, "Pop_All empties");
+
+    DECREF(got);
+    DECREF(top_k);
+
+    top_k = TopK_new(0, S_ascending, NULL);
+    TEST_FALSE(runner, TopK_Insert(top_k, (Obj*)Int_new(1)),
+               "Insert into zero-sized collector");
+    DECREF(top_k);
+}
+
+static void
+test_random(TestBatchRunner *runner) {
+    int64_t *nums   = TestUtils_random_i64s(NULL, 1000, 0, 500);
+    Vector  *wanted = Vec_new(1000);
+    TopK    *top_k  = TopK_new(20, S_descending, NULL);
+
+    for (size_t i = 0; i < 1000; i++) {
+        Vec_Push(wanted, (Obj*)Int_new(nums[i]));
+        TopK_Insert(top_k, (Obj*)Int_new(nums[i]));
+    }
+    Vec_Sort(wanted);
+    Vec_Excise(wanted, 0, 980);
+
+    Vector *got = TopK_Pop_All(top_k);
+    bool    ok  = Vec_Get_Size(got) == 20;
+    for (size_t i = 0; ok && i < 20; i++) {
+        ok = Obj_Equals(Vec_Fetch(got, i), Vec_Fetch(wanted, 19 - i));
+    }
+    TEST_TRUE(runner, ok, "Collect largest elements with reversed compare");
+
+    DECREF(got);
+    DECREF(top_k);
+    DECREF(wanted);
+    FREEMEM(nums);
+}
+
+void
+TestTopK_Run_IMP(TestTopK *self, TestBatchRunner *runner) {
+    TestBatchRunner_Plan(runner, (TestBatch*)self, 13);
+    test_Insert(runner);
+    test_random(runner);
+}
+